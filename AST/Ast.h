@@ -2,7 +2,7 @@
 #define AST_H
 //////////////////////////////////////////////////////////////////////////////
 // Ast.h - Has helper functions for tree operations                         //
-// ver 1.1                                                                  //
+// ver 1.2                                                                  //
 // Language:    C++, Visual Studio 2015                                      //
 // Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
 //              Alienware R15, Core i5, Windows 10                           //
@@ -36,6 +36,8 @@ devenv ScopeStack.sln /rebuild debug
 
 Maintenance History:
 ====================
+ver 1.2 : 10/18/26
+- added reset(), so funct() prints its table heading for each file
 ver 1.1 : 03/16/15
 - added methods to find complexity
 ver 1.0 : 03/13/15
@@ -55,6 +57,7 @@ public:
 	element* getRoot();
 	void setRoot(element* node);
 	void funct(element* node);
+	void reset() { count = 1; }
 	//int getComplexity(element*);
 private:
 	 int complexity;
@@ -1,6 +1,6 @@
 //////////////////////////////////////////////////////////////////////////////
 // MetricsAnalysis.cpp - Support file and directory operations              //
-// ver 1.0                                                                  //                                                                //
+// ver 1.2                                                                  //                                                                //
 // Language:    C++, Visual Studio 2015                                     //
 // Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
 //              Alienware R15, Core i5, Windows 10                           //
@@ -27,6 +27,10 @@ devenv ScopeStack.sln /rebuild debug
 
 Maintenance History:
 ====================
+ver 1.2 : 10/18/26
+- test stub says why a file could not be attached
+ver 1.1 : 10/18/26
+- test stub builds one parser and reuses it for every file
 ver 1.0 : 03/15/15
 - first release
 */
@@ -45,19 +49,19 @@ void main()
 	fm.search();
 	std::cout << "\n\n  contents of DataStore";
 	std::cout << "\n -----------------------";
+	ConfigParseToConsole configure;                 // built once, reused for each file
+	Parser* pParser = configure.Build();
 	for (auto fs : ds)
 	{
 		std::string fileSpec = FileSystem::Path::getFullFileSpec(fs);
 		std::string msg = "Processing file ->" + fileSpec;
-		ConfigParseToConsole configure;
 		//Ast showComplexities;
-		Parser* pParser = configure.Build();
 		try {
 			if (pParser)
 			{
 				if (!configure.Attach(fs))
 				{
-					std::cout << "\n  could not open file " << fileSpec << std::endl;
+					std::cout << "\n  could not open file " << fileSpec << ": " << configure.attachError() << std::endl;
 				}
 			}
 			else   std::cout << "\n\n  Parser not built\n\n";
@@ -1,6 +1,6 @@
 ///////////////////////////////////////////////////////////////////////
 // MetricsExecutive.cpp - Test package to test requirements			  //
-// ver 1.0                                                           //
+// ver 1.2                                                           //
 // Language:    C++, Visual Studio 2015                              //
 // Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
 //              Alienware R15, Core i5, Windows 10                           //
@@ -13,6 +13,10 @@
 /*
 Maintenance History:
 ====================
+ver 1.2 : 18 Oct 2026
+- says why a file could not be attached
+ver 1.1 : 18 Oct 2026
+- testRequirement8_9 builds one parser and reuses it for every file
 ver 1 : 10 Feb 16
 - added a functions to test all the requirements
 */
@@ -78,7 +82,7 @@ void TestExe::testRequirement5_6()		 //to display requirement 5 and 6
 		{
 			if (!configure.Attach("../Testfile/test.txt"))
 			{
-				std::cout << "\n  could not open file " << fileSpec << std::endl;
+				std::cout << "\n  could not open file " << fileSpec << ": " << configure.attachError() << std::endl;
 				//continue;
 			}
 		}
@@ -141,21 +145,21 @@ void TestExe::testRequirement8_9(std::string filename)			 //to display requireme
 	std::cout << "\n\n The directory is " << filename;
 	std::cout << "\n\n  contents of DataStore";
 	std::cout << "\n -----------------------";
+	ConfigParseToConsole configure;                 // built once, reused for each file
+	Parser* pParser = configure.Build2();
 	for (auto fs : ds)
 	{
 		//std::string fileSpec = FileSystem::Path::getFullFileSpec(fs);
 		std::string fileSpec = fs;
 		std::string msg = "Processing file ->" + fileSpec;
 		std::cout << "\n\n --" << msg << "\n\n";
-		ConfigParseToConsole configure;
 		//Ast showComplexities;
-		Parser* pParser = configure.Build2();
 		try {
 			if (pParser)
 			{
 				if (!configure.Attach(fs))
 				{
-					std::cout << "\n  could not open file " << fileSpec << std::endl;
+					std::cout << "\n  could not open file " << fileSpec << ": " << configure.attachError() << std::endl;
 				}
 			}
 			else   std::cout << "\n\n  Parser not built\n\n";
@@ -2,7 +2,7 @@
 #define ACTIONSANDRULES_H
 /////////////////////////////////////////////////////////////////////
 //  ActionsAndRules.h - declares new parsing rules and actions     //
-//  ver 2.2                                                        //
+//  ver 2.9                                                        //
 // Language:    C++, Visual Studio 2015                                      //
 // Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
 //              Alienware R15, Core i5, Windows 10                           //
@@ -45,6 +45,26 @@ semiexpression.cpp tokenizer.cpp /link setargv.obj
 
 Maintenance History:
 ====================
+ver 2.9 : 18 Oct 2026
+- PreprocStatement also fires for a directive token, which Toker
+  returns when returnDirectives() is on
+ver 2.8 : 18 Oct 2026
+- Declaration and Executable stop after "!=", "<=", and ">=".  Toker
+  returns them whole now, instead of splitting them before the "="
+  these rules stop at, so they are classified as before.
+ver 2.7 : 18 Oct 2026
+- added Repository::reset(), so one parser can process many files
+ver 2.6 : 18 Oct 2026
+- scope start and end lines are the exact lines of their { and }
+ver 2.5 : 18 Oct 2026
+- Repository takes the line count from SemiExp, which collects tokens
+  from Toker in batches
+ver 2.4 : 18 Oct 2026
+- rules compare interned token ids, e.g., Tok::lbrace, Tok::kw_for,
+  instead of token strings
+ver 2.3 : 18 Oct 2026
+- rules and actions test token kinds from the tokenizer instead of
+  re-examining token text for comments, newlines, and keywords
 ver 2.2 : 16 March 16
 - added rules and actions to detect and handle differenct C++ scopes
 ver 2.1 : 15 Feb 16
@@ -70,6 +90,10 @@ ver 1.0 : 12 Jan 06
 #include "../SemiExp/SemiExp.h"
 #include "../StructElement/StructElement.h"
 #include "../AST/Ast.h"
+#include "../Tokenizer/TokenTable.h"
+
+using Scanner::TokenId;
+namespace Tok = Scanner::Tok;     // fixed ids of keywords and punctuators
 
 ///////////////////////////////////////////////////////////////
 
@@ -87,6 +111,7 @@ class Repository  // application specific
 {
   ScopeStack<element*> stack;
   Scanner::Toker* p_Toker;
+  Scanner::SemiExp* p_Semi;
   
 public:
 	Ast* astRoot = new Ast;
@@ -98,9 +123,23 @@ public:
 		stack.push(root);
 		astRoot->setRoot(root);
 	}
-  Repository(Scanner::Toker* pToker)
+  Repository(Scanner::Toker* pToker, Scanner::SemiExp* pSemi = nullptr)
   {
     p_Toker = pToker;
+    p_Semi = pSemi;
+  }
+  // discard the last file's tree and start again at the global root
+  void reset()
+  {
+    while (stack.size() > 0)
+      stack.pop();
+    for (element* pChild : root->_children)
+      deleteTree(pChild);
+    root->_children.clear();
+    root->startLineCount = 0;
+    root->endLineCount = 0;
+    astRoot->reset();
+    addRoot();
   }
   ScopeStack<element*>& scopeStack()
   {
@@ -112,8 +151,19 @@ public:
   }
   size_t lineCount()
   {
+    // line of the semi-expression's last token, e.g., the { or } of
+    // a scope.  The Toker reads ahead of the parser, so ask SemiExp.
+    if (p_Semi != nullptr)
+      return p_Semi->currentLineCount();
     return (size_t)(p_Toker->currentLineCount());
   }
+private:
+  static void deleteTree(element* pElem)
+  {
+    for (element* pChild : pElem->_children)
+      deleteTree(pChild);
+    delete pElem;
+  }
 };
 
 ///////////////////////////////////////////////////////////////
@@ -124,7 +174,7 @@ class BeginningOfScope : public IRule
 public:
   bool doTest(ITokCollection*& pTc)
   {
-    if(pTc->find("{") < pTc->length())
+    if(pTc->find(Tok::lbrace) < pTc->length())
     {
       doActions(pTc);
       return true;
@@ -165,7 +215,7 @@ class EndOfScope : public IRule
 public:
   bool doTest(ITokCollection*& pTc)
   {
-    if(pTc->find("}") < pTc->length())
+    if(pTc->find(Tok::rbrace) < pTc->length())
     {
       doActions(pTc);
       return true;
@@ -225,10 +275,17 @@ public:
 
 class PreprocStatement : public IRule
 {
+  bool hasDirective(ITokCollection* pTc)
+  {
+    for (size_t i = 0; i < pTc->length(); ++i)
+      if (pTc->kind(i) == Scanner::TokenKind::directive)
+        return true;
+    return false;
+  }
 public:
   bool doTest(ITokCollection*& pTc)
   {
-    if(pTc->find("#") < pTc->length())
+    if(pTc->find(Tok::hash) < pTc->length() || hasDirective(pTc))
     {
       doActions(pTc);
       return true;
@@ -256,22 +313,24 @@ public:
 class Loop : public IRule
 {
 public:
-	bool isSpecialKeyWord(const std::string& tok)                   // to detect for or if or while conditions
+	bool isSpecialKeyWord(TokenId id)                   // to detect for or if or while conditions
 	{
-		const static std::string keys[]
-			= { "for", "while", "switch", "if", "else", "catch" };
-		for (int i = 0; i<6; ++i)
-			if (tok == keys[i])
-				return true;
-		return false;
+		switch (id)
+		{
+		case Tok::kw_for: case Tok::kw_while: case Tok::kw_switch:
+		case Tok::kw_if: case Tok::kw_else: case Tok::kw_catch:
+			return true;
+		default:
+			return false;
+		}
 	}
 	bool doTest(ITokCollection*& pTc)
 	{
 		ITokCollection& tc = *pTc;
-		if (tc[tc.length() - 1] == "{")
+		if (tc.id(tc.length() - 1) == Tok::lbrace)
 		{
-			size_t len = tc.find("(");
-		    if ((len < tc.length() && isSpecialKeyWord(tc[len - 1])) || (pTc->find("else") < pTc->length()))
+			size_t len = tc.find(Tok::lparen);
+		    if ((len < tc.length() && isSpecialKeyWord(tc.id(len - 1))) || (pTc->find(Tok::kw_else) < pTc->length()))
 			{
 				doActions(pTc);
 				return true;
@@ -294,7 +353,7 @@ public:
 		p_Repos->scopeStack().pop();
 		p_Repos->scopeStack().top()->_children.pop_back();
 		
-		std::string name = (*pTc)[pTc->find("(") - 1];
+		std::string name = (*pTc)[pTc->find(Tok::lparen) - 1];
 		element* elem = new element;
 		elem->type = "Loop or Control";
 		elem->name = "Scope names";
@@ -314,16 +373,17 @@ class PrintLoop : public IAction
 	}
 	void doAction(ITokCollection*& pTc)
 	{
-		std::string name = (*pTc)[pTc->find("(") - 1];
-		if(name == "for")
+		size_t paren = pTc->find(Tok::lparen);
+		TokenId name = paren < pTc->length() && paren > 0 ? pTc->id(paren - 1) : Tok::none;
+		if(name == Tok::kw_for)
 		std::cout << "\n  Forloop: " << pTc->show().c_str();
-		else if(name == "if")
+		else if(name == Tok::kw_if)
 			std::cout << "\n  If condition: " << pTc->show().c_str();
-		else if (name == "while")
+		else if (name == Tok::kw_while)
 			std::cout << "\n  While loop: " << pTc->show().c_str();
-		else if (name == "switch")
+		else if (name == Tok::kw_switch)
 			std::cout << "\n  Switch: " << pTc->show().c_str();
-		else if (name == "catch")
+		else if (name == Tok::kw_catch)
 			std::cout << "\n  Catch: " << pTc->show().c_str();
 		else 
 			std::cout << "\n  Else: " << pTc->show().c_str();
@@ -336,22 +396,18 @@ class PrintLoop : public IAction
 class ClassStruct : public IRule
 {
 public:
-	bool isClassStruct(const std::string& tok)
+	bool isClassStruct(TokenId id)
 	{
-		const static std::string keys[] = { "class", "struct" };
-		for (int i = 0; i < 2; i++)
-			if (tok == keys[i])
-				return true;
-		return false;
+		return id == Tok::kw_class || id == Tok::kw_struct;
 	}
 	bool doTest(ITokCollection*& pTc)
 	{
 		ITokCollection& tc = *pTc;
-		if (tc[tc.length() - 1] == "{")
+		if (tc.id(tc.length() - 1) == Tok::lbrace)
 		{
 			//size_t len = tc.find("{");
 			//if ((len < tc.length() && isClassStruct(tc[len-2])) || (len < tc.length() && isClassStruct(tc[len-2])))
-			if((pTc->find("struct") < pTc->length()) || (pTc->find("class") < pTc->length()))
+			if((pTc->find(Tok::kw_struct) < pTc->length()) || (pTc->find(Tok::kw_class) < pTc->length()))
 			{
 				//std::cout << "Handle inside clss\n";
 				doActions(pTc);
@@ -380,7 +436,7 @@ public:
 		p_Repos->scopeStack().top()->_children.pop_back();
 
 		// push function scope
-		std::string name = (*pTc)[pTc->find("{") - 2];
+		std::string name = (*pTc)[pTc->find(Tok::lbrace) - 2];
 		//std::cout << pTc->find("struct") << "\n";
 		element* elem = new element;
 		elem->type = "class or structure";
@@ -416,14 +472,16 @@ public:
 class lambda : public IRule
 {
 public:
-	bool isSpecialKeyWord(const std::string& tok)
+	bool isSpecialKeyWord(TokenId id)
 	{
-		const static std::string keys[]
-			= { "for", "while", "switch", "if", "catch" };
-		for (int i = 0; i<5; ++i)
-			if (tok == keys[i])
-				return true;
-		return false;
+		switch (id)
+		{
+		case Tok::kw_for: case Tok::kw_while: case Tok::kw_switch:
+		case Tok::kw_if: case Tok::kw_catch:
+			return true;
+		default:
+			return false;
+		}
 	}
 
 	bool doTest(ITokCollection*& pTc)
@@ -431,10 +489,10 @@ public:
 		ITokCollection& tc = *pTc;
 		//if (tc[tc.length() - 1] == "{")
 		//{
-			size_t len = tc.find("(");
-			size_t len1 = tc.find("]");
-			size_t len2 = tc.find("[");
-			size_t len3 = tc.find("=");
+			size_t len = tc.find(Tok::lparen);
+			size_t len1 = tc.find(Tok::rbracket);
+			size_t len2 = tc.find(Tok::lbracket);
+			size_t len3 = tc.find(Tok::assign);
 			if ((len - len1 == 1) || (len2 - len3 == 1) /* && !isSpecialKeyWord(tc[len - 1])*/)
 			{
 				doActions(pTc);
@@ -499,25 +557,27 @@ public:
 class FunctionDefinition : public IRule
 {
 public:
-  bool isSpecialKeyWord(const std::string& tok)
+  bool isSpecialKeyWord(TokenId id)
   {
-    const static std::string keys[]
-      = { "for", "while", "switch", "if", "catch" };
-    for(int i=0; i<5; ++i)
-      if(tok == keys[i])
-        return true;
-    return false;
+    switch (id)
+    {
+    case Tok::kw_for: case Tok::kw_while: case Tok::kw_switch:
+    case Tok::kw_if: case Tok::kw_catch:
+      return true;
+    default:
+      return false;
+    }
   }
   bool doTest(ITokCollection*& pTc)
   {
     ITokCollection& tc = *pTc;
-    if(tc[tc.length()-1] == "{")
+    if(tc.id(tc.length()-1) == Tok::lbrace)
     {
-      size_t len = tc.find("(");
-	  size_t len1 = tc.find("]");
-	  size_t len2 = tc.find("[");
-	  size_t len3 = tc.find("=");
-      if(len < tc.length() && !isSpecialKeyWord(tc[len-1]) && !((len - len1) == 1) && !(len2 - len3 == 1))
+      size_t len = tc.find(Tok::lparen);
+	  size_t len1 = tc.find(Tok::rbracket);
+	  size_t len2 = tc.find(Tok::lbracket);
+	  size_t len3 = tc.find(Tok::assign);
+      if(len < tc.length() && !isSpecialKeyWord(tc.id(len-1)) && !((len - len1) == 1) && !(len2 - len3 == 1))
       {
         doActions(pTc);
         return true;
@@ -548,7 +608,7 @@ public:
 	p_Repos->scopeStack().top()->_children.pop_back();
 
     // push function scope
-    std::string name = (*pTc)[pTc->find("(") - 1];
+    std::string name = (*pTc)[pTc->find(Tok::lparen) - 1];
     element* elem = new element;
     elem->type = "function";
     elem->name = name;
@@ -587,7 +647,7 @@ public:
     pTc->remove("public");
     pTc->remove(":");
     pTc->trimFront();
-    size_t len = pTc->find(")");
+    size_t len = pTc->find(Tok::rparen);
     std::cout << "\n\n  Pretty Stmt:    ";
     for(int i=0; i<len+1; ++i)
       std::cout << (*pTc)[i] << " ";
@@ -601,23 +661,29 @@ public:
 class Declaration : public IRule          // declar ends in semicolon
 {                                         // has type, name, modifiers &
 public:                                   // initializers.  So eliminate
-  bool isModifier(const std::string& tok) // modifiers and initializers.
+  bool isModifier(TokenId id)             // modifiers and initializers.
   {                                       // If you have two things left
-    const size_t numKeys = 22;            // its declar else executable.
-    const static std::string keys[numKeys] = {
-      "const", "extern", "friend", "mutable", "signed", "static",
-      "typedef", "typename", "unsigned", "volatile", "&", "*", "std", "::",
-      "public", "protected", "private", ":", "typename", "typedef", "++", "--"
-    };
-    for (int i = 0; i<numKeys; ++i)
-    if (tok == keys[i])
+    switch (id)                           // its declar else executable.
+    {
+    case Tok::kw_const: case Tok::kw_extern: case Tok::kw_friend:
+    case Tok::kw_mutable: case Tok::kw_signed: case Tok::kw_static:
+    case Tok::kw_typedef: case Tok::kw_typename: case Tok::kw_unsigned:
+    case Tok::kw_volatile: case Tok::amp: case Tok::star: case Tok::id_std:
+    case Tok::scope: case Tok::kw_public: case Tok::kw_protected:
+    case Tok::kw_private: case Tok::colon: case Tok::plusPlus: case Tok::minusMinus:
       return true;
-    return false;
+    default:
+      return false;
+    }
+  }
+  bool isComparison(TokenId id)
+  {
+    return id == Tok::notEqual || id == Tok::lessEqual || id == Tok::greaterEqual;
   }
   void condenseTemplateTypes(ITokCollection& tc)
   {
-    size_t start = tc.find("<");
-    size_t end = tc.find(">");
+    size_t start = tc.find(Tok::less);
+    size_t end = tc.find(Tok::greater);
     if (start >= end || start == 0)
       return;
     else
@@ -641,22 +707,24 @@ public:                                   // initializers.  So eliminate
     tc[start - 1] = tok;
     //std::cout << "\n  -- " << tc.show();
   }
-  bool isSpecialKeyWord(const std::string& tok)
+  bool isSpecialKeyWord(TokenId id)
   {
-    const static std::string keys[]
-      = { "for", "while", "switch", "if", "catch" };
-    for (int i = 0; i<5; ++i)
-    if (tok == keys[i])
+    switch (id)
+    {
+    case Tok::kw_for: case Tok::kw_while: case Tok::kw_switch:
+    case Tok::kw_if: case Tok::kw_catch:
       return true;
-    return false;
+    default:
+      return false;
+    }
   }
   void removeInvocationParens(ITokCollection& tc)
   {
-    size_t start = tc.find("(");
-    size_t end = tc.find(")");
+    size_t start = tc.find(Tok::lparen);
+    size_t end = tc.find(Tok::rparen);
     if (start >= end || end == tc.length() || start == 0)
       return;
-    if (isSpecialKeyWord(tc[start - 1]))
+    if (isSpecialKeyWord(tc.id(start - 1)))
       return;
     for (size_t i = start; i < end + 1; ++i)
       tc.remove(start);
@@ -667,9 +735,9 @@ public:                                   // initializers.  So eliminate
     ITokCollection& in = *pTc;
     Scanner::SemiExp tc;
     for (size_t i = 0; i<in.length(); ++i)
-      tc.push_back(in[i]);
+      tc.push_back(in[i], in.kind(i));
 
-    if (tc[tc.length() - 1] == ";" && tc.length() > 2)
+    if (tc.id(tc.length() - 1) == Tok::semicolon && tc.length() > 2)
     {
       //std::cout << "\n  ++ " << tc.show();
       removeInvocationParens(tc);
@@ -680,14 +748,16 @@ public:                                   // initializers.  So eliminate
       Scanner::SemiExp se;
       for (size_t i = 0; i < tc.length(); ++i)
       {
-        if (isModifier(tc[i]))
+        TokenId id = tc.id(i);
+        if (isModifier(id))
           continue;
-        if (se.isComment(tc[i]) || tc[i] == "\n" || tc[i] == "return")
+        if (tc.kind(i) == Scanner::TokenKind::comment || id == Tok::newline || id == Tok::kw_return)
           continue;
-        if (tc[i] == "=" || tc[i] == ";")
+        if (id == Tok::assign || id == Tok::semicolon)
+          break;
+        se.push_back(tc[i], tc.kind(i));
+        if (isComparison(id))
           break;
-        else
-          se.push_back(tc[i]);
       }
       //std::cout << "\n  ** " << se.show();
       if (se.length() == 2)  // type & name, so declaration
@@ -712,8 +782,8 @@ public:
     // remove comments
     Scanner::SemiExp se;
     for (size_t i = 0; i<tc.length(); ++i)
-      if (!se.isComment(tc[i]))
-        se.push_back(tc[i]);
+      if (tc.kind(i) != Scanner::TokenKind::comment)
+        se.push_back(tc[i], tc.kind(i));
     // show cleaned semiExp
     std::cout << "\n  Declaration: " << se.show();
   }
@@ -725,23 +795,29 @@ public:
 class Executable : public IRule           // declar ends in semicolon
 {                                         // has type, name, modifiers &
 public:                                   // initializers.  So eliminate
-  bool isModifier(const std::string& tok) // modifiers and initializers.
+  bool isModifier(TokenId id)             // modifiers and initializers.
   {                                       // If you have two things left
-    const size_t numKeys = 22;            // its declar else executable.
-    const static std::string keys[numKeys] = {
-      "const", "extern", "friend", "mutable", "signed", "static",
-      "typedef", "typename", "unsigned", "volatile", "&", "*", "std", "::",
-      "public", "protected", "private", ":", "typename", "typedef", "++", "--"
-    };
-    for (int i = 0; i<numKeys; ++i)
-    if (tok == keys[i])
+    switch (id)                           // its declar else executable.
+    {
+    case Tok::kw_const: case Tok::kw_extern: case Tok::kw_friend:
+    case Tok::kw_mutable: case Tok::kw_signed: case Tok::kw_static:
+    case Tok::kw_typedef: case Tok::kw_typename: case Tok::kw_unsigned:
+    case Tok::kw_volatile: case Tok::amp: case Tok::star: case Tok::id_std:
+    case Tok::scope: case Tok::kw_public: case Tok::kw_protected:
+    case Tok::kw_private: case Tok::colon: case Tok::plusPlus: case Tok::minusMinus:
       return true;
-    return false;
+    default:
+      return false;
+    }
+  }
+  bool isComparison(TokenId id)
+  {
+    return id == Tok::notEqual || id == Tok::lessEqual || id == Tok::greaterEqual;
   }
   void condenseTemplateTypes(ITokCollection& tc)
   {
-    size_t start = tc.find("<");
-    size_t end = tc.find(">");
+    size_t start = tc.find(Tok::less);
+    size_t end = tc.find(Tok::greater);
     if (start >= end || start == 0)
       return;
     else
@@ -766,22 +842,24 @@ public:                                   // initializers.  So eliminate
     //std::cout << "\n  -- " << tc.show();
   }
   
-  bool isSpecialKeyWord(const std::string& tok)
+  bool isSpecialKeyWord(TokenId id)
   {
-    const static std::string keys[]
-      = { "for", "while", "switch", "if", "catch" };
-    for (int i = 0; i<5; ++i)
-    if (tok == keys[i])
+    switch (id)
+    {
+    case Tok::kw_for: case Tok::kw_while: case Tok::kw_switch:
+    case Tok::kw_if: case Tok::kw_catch:
       return true;
-    return false;
+    default:
+      return false;
+    }
   }
   void removeInvocationParens(ITokCollection& tc)
   {
-    size_t start = tc.find("(");
-    size_t end = tc.find(")");
+    size_t start = tc.find(Tok::lparen);
+    size_t end = tc.find(Tok::rparen);
     if (start >= end || end == tc.length() || start == 0)
       return;
-    if (isSpecialKeyWord(tc[start - 1]))
+    if (isSpecialKeyWord(tc.id(start - 1)))
       return;
     for (size_t i = start; i < end + 1; ++i)
       tc.remove(start);
@@ -793,9 +871,9 @@ public:                                   // initializers.  So eliminate
     Scanner::SemiExp tc;
 	//std::cout << in.length() << "\n";
     for (size_t i = 0; i<in.length(); ++i)
-      tc.push_back(in[i]);
+      tc.push_back(in[i], in.kind(i));
 
-    if (tc[tc.length() - 1] == ";" && tc.length() > 2)
+    if (tc.id(tc.length() - 1) == Tok::semicolon && tc.length() > 2)
     {
       //std::cout << "\n  ++ " << tc.show();
       removeInvocationParens(tc);
@@ -806,14 +884,16 @@ public:                                   // initializers.  So eliminate
       Scanner::SemiExp se;
       for (size_t i = 0; i < tc.length(); ++i)
       {
-        if (isModifier(tc[i]))
+        TokenId id = tc.id(i);
+        if (isModifier(id))
           continue;
-        if (se.isComment(tc[i]) || tc[i] == "\n" || tc[i] == "return")
+        if (tc.kind(i) == Scanner::TokenKind::comment || id == Tok::newline || id == Tok::kw_return)
           continue;
-        if (tc[i] == "=" || tc[i] == ";")
+        if (id == Tok::assign || id == Tok::semicolon)
+          break;
+        se.push_back(tc[i], tc.kind(i));
+        if (isComparison(id))
           break;
-        else
-          se.push_back(tc[i]);
       }
       //std::cout << "\n  ** " << se.show();
       if (se.length() != 2)  // not a declaration
@@ -839,8 +919,8 @@ public:
     Scanner::SemiExp se;
     for (size_t i = 0; i < tc.length(); ++i)
     {
-      if (!se.isComment(tc[i]))
-        se.push_back(tc[i]);
+      if (tc.kind(i) != Scanner::TokenKind::comment)
+        se.push_back(tc[i], tc.kind(i));
     }
     // show cleaned semiExp
     std::cout << "\n  Executable: " << se.show();
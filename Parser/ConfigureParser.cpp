@@ -1,6 +1,6 @@
 ///////////////////////////////////////////////////////////////////////////////
 //  ConfigureParser.cpp - builds and configures parsers                        //
-//  ver 2.2                                                                  //
+//  ver 2.9                                                                  //
 //                                                                           //
 // Language:    C++, Visual Studio 2015                                      //
 // Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
@@ -22,6 +22,7 @@ ConfigParseToConsole conConfig;
 conConfig.Build();- all the parts get assembled
 conConfig.Attach(someFileName); - attach toker to a file stream or stringstream
 treeWalk - calls the display tree function
+conConfig.Attach(anotherFileName); - reuse the parts for another file
 
 Build Process:
 ==============
@@ -37,6 +38,25 @@ semiexpression.cpp tokenizer.cpp /link setargv.obj
 
 Maintenance History:
 ====================
+ver 2.9 : 18 Oct 2026
+- Attach() maps files into memory, so the Toker lexes a buffer, and
+  reads the file as a stream only if it can't be mapped
+ver 2.8 : 18 Oct 2026
+- Attach() inflates *.gz files only in builds with BYTESOURCE_ZLIB,
+  other builds read them as before
+ver 2.7 : 18 Oct 2026
+- Attach() records why it failed, and attachError() reports it, with
+  a GzipByteSource's own error, e.g., that the build has no zlib
+ver 2.6 : 18 Oct 2026
+- the SemiExp reads a TokenTee on the Toker, so clients added with
+  addTokenConsumer() or addTokenQueue() share the parser's lexing pass
+ver 2.5 : 18 Oct 2026
+- the Toker returns each preprocessor directive as one token, so a
+  #define continued over several lines is one semiExpression
+ver 2.4 : 18 Oct 2026
+- Attach() streams *.gz files through a GzipByteSource
+ver 2.3 : 18 Oct 2026
+- Attach() reuses the parts built once for each new file
 ver 2.2 : 14 Mar 16
 - Added treeWalk function and showComptable
 ver 2.1 : 19 Feb 16
@@ -76,32 +96,118 @@ ConfigParseToConsole::~ConfigParseToConsole()
   delete pShowDeclaration;
   delete pExecutable;
   delete pShowExecutable;
+  delete pPreprocStatement;
+  delete pPrintPreproc;
+  delete pLoop;
+  delete ppushLoop;
+  delete pPrintLoop;
+  delete pClassStruct;
+  delete ppushClassStruct;
+  delete pshowClassStruct;
+  delete pLambda;
+  delete pPushLambda;
+  delete pShowLambda;
   delete pRepo;
   delete pParser;
   delete pSemi;
+  delete pTee;
   delete pToker;
-  pIn->close();
-  delete pIn;
 }
-//----< attach toker to a file stream or stringstream >------------
-
+//----< attach toker to a mapped file, or a file stream >-----------
+/*
+ * Parts are reused from file to file:  the SemiExp drops tokens read
+ * ahead, the Repository starts a new tree, and the one MappedFile, or
+ * ifstream if the file can't be mapped, is reopened, so nothing is
+ * rebuilt.  Token views of the previous file end with its mapping.
+ * In a build with BYTESOURCE_ZLIB, a file named *.gz is inflated on
+ * the GzipByteSource's thread while it's parsed, so lines are those of
+ * the uncompressed source.  The previous source lives until the Toker
+ * is attached to the new one.  Other builds read it like any file.
+ */
 bool ConfigParseToConsole::Attach(const std::string& name, bool isFile)
 {
+  errorText.clear();
   if(pToker == 0)
+  {
+    errorText = "parser not built";
     return false;
-  pIn = new std::ifstream(name);
-  if (!pIn->good())
+  }
+  pSemi->reset();
+  pTee->restart();
+  pRepo->reset();
+  in.close();
+  in.clear();
+#ifdef BYTESOURCE_ZLIB
+  const std::string gzSuffix = ".gz";
+  if (name.size() > gzSuffix.size() && name.compare(name.size() - gzSuffix.size(), gzSuffix.size(), gzSuffix) == 0)
+  {
+    std::unique_ptr<GzipByteSource> pSource(new GzipByteSource(name));
+    if (!pSource->isOpen() || !pToker->attach(pSource.get()))
+    {
+      errorText = pSource->error().size() > 0 ? pSource->error() : "can't open " + name;
+      return false;
+    }
+    pGzSource = std::move(pSource);
+    mapped.close();
+    return true;
+  }
+#endif
+  if (mapped.open(name) && pToker->attach(mapped))
+  {
+    pGzSource.reset();
+    return true;
+  }
+  mapped.close();
+  in.open(name);
+  if (!in.good() || !pToker->attach(&in))
+  {
+    errorText = "can't open " + name;
     return false;
-  return pToker->attach(pIn);
+  }
+  pGzSource.reset();
+  return true;
+}
+//----< why Attach() failed, or why a *.gz file's text was cut short >
+/*
+ * A compressed file's errors, e.g., truncation, are found as it is
+ * inflated, so they are known once the parse has read all its text.
+ */
+std::string ConfigParseToConsole::attachError()
+{
+  if (errorText.empty() && pGzSource != nullptr)
+    return pGzSource->error();
+  return errorText;
 }
+//----< give pConsumer the tokens of every file parsed >-----------
+/*
+ * The consumer is called on the parser's thread, with each batch the
+ * SemiExp reads, so it costs no second lexing pass.
+ */
+void ConfigParseToConsole::addTokenConsumer(Scanner::ITokenConsumer* pConsumer)
+{
+  if (pTee != nullptr)
+    pTee->addConsumer(pConsumer);
+}
+//----< queue of the attached file's tokens, for another thread >---
+/*
+ * Batches of a mapped file refer to the mapping, so the client must
+ * be done with them before the next Attach() closes it.
+ */
+std::shared_ptr<TokenQueue> ConfigParseToConsole::addTokenQueue(size_t maxBatches)
+{
+  if (pTee == nullptr)
+    return nullptr;
+  return pTee->addQueue(maxBatches);
+}
 //----< Here's where alll the parts get assembled >----------------
 
 Parser* ConfigParseToConsole::Build()
 {
   try
   {// add Parser's main parts
-pToker = new Toker; pToker->returnComments(false); pSemi = new SemiExp(pToker);
-    pParser = new Parser(pSemi); pRepo = new Repository(pToker);
+pToker = new Toker; pToker->returnComments(false); pToker->returnDirectives();
+    pTee = new TokenTee(*pToker); pSemi = new SemiExp(pTee);
+    pParser = new Parser(pSemi); pRepo = new Repository(pToker, pSemi);
 	pRepo->addRoot();
     // configure to manage scope
     // these must come first - they return true on match
@@ -151,9 +257,9 @@ Parser* ConfigParseToConsole::Build2()
 {
 	try
 	{// add Parser's main parts
-	    pToker = new Toker;		pToker->returnComments(false);
-		pSemi = new SemiExp(pToker);		pParser = new Parser(pSemi);
-		pRepo = new Repository(pToker);		pRepo->addRoot();
+	    pToker = new Toker;		pToker->returnComments(false);	pToker->returnDirectives();
+		pTee = new TokenTee(*pToker);		pSemi = new SemiExp(pTee);		pParser = new Parser(pSemi);
+		pRepo = new Repository(pToker, pSemi);		pRepo->addRoot();
         // configure to manage scope, these must come first - they return true on match so rule checking continues
      	pBeginningOfScope = new BeginningOfScope();		pHandlePush = new HandlePush(pRepo);
 		pBeginningOfScope->addAction(pHandlePush);		pParser->addRule(pBeginningOfScope);
@@ -229,29 +335,28 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  // build the parser once, and reuse it for every file
+
+  ConfigParseToConsole configure;
+  Parser* pParser = configure.Build();
+  if(!pParser)
+  {
+    std::cout << "\n\n  Parser not built\n\n";
+    return 1;
+  }
+
   for(int i=1; i<argc; ++i)
   {
     std::cout << "\n  Processing file " << argv[i];
     std::cout << "\n  " << std::string(16 + strlen(argv[i]),'-');
 
-    ConfigParseToConsole configure;
-    Parser* pParser = configure.Build();
     try
     {
-      if(pParser)
-      {
-        if(!configure.Attach(argv[i]))
-        {
-          std::cout << "\n  could not open file " << argv[i] << std::endl;
-          continue;
-        }
-      }
-      else
+      if(!configure.Attach(argv[i]))
       {
-        std::cout << "\n\n  Parser not built\n\n";
-        return 1;
+        std::cout << "\n  could not open file " << argv[i] << ": " << configure.attachError() << std::endl;
+        continue;
       }
-      // now that parser is built, use it
 
       while(pParser->next())
         pParser->parse();
@@ -2,7 +2,7 @@
 #define CONFIGUREPARSER_H
 ///////////////////////////////////////////////////////////////////////////////
 //  ConfigureParser.h - builds and configures parsers                        //
-//  ver 2.2                                                                  //
+//  ver 2.9                                                                  //
 //                                                                           //
 // Language:    C++, Visual Studio 2015                                      //
 // Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
@@ -22,15 +22,24 @@ Public Interface:
 =================
 ConfigParseToConsole conConfig;
 conConfig.Build();- all the parts get assembled
-conConfig.Attach(someFileName); - attach toker to a file stream or stringstream
+conConfig.Attach(someFileName); - attach toker to the file, mapped into memory,
+  or read as a stream if it can't be mapped
 treeWalk - calls the display tree function
+conConfig.Attach(anotherFileName); - reuse the parts for another file
+conConfig.Attach("snapshot/Parser.cpp.gz"); - inflated as it's parsed, with zlib
+conConfig.attachError(); - why Attach() failed, or the .gz file is bad
+conConfig.addTokenConsumer(&lineCounter); - gets the tokens the parser's
+  one lexing pass produces, for every file
+conConfig.addTokenQueue(); - the same, for a client on another thread,
+  after each Attach(), and read before the next one
 
 Build Process:
 ==============
 Required files
 - ConfigureParser.h, ConfigureParser.cpp, Parser.h, Parser.cpp,
 ActionsAndRules.h, ActionsAndRules.cpp,
-SemiExpression.h, SemiExpression.cpp, tokenizer.h, tokenizer.cpp
+SemiExpression.h, SemiExpression.cpp, tokenizer.h, tokenizer.cpp,
+MappedFile.h, MappedFile.cpp
 Build commands (either one)
 - devenv Project1HelpS06.sln
 - cl /EHsc /DTEST_PARSER ConfigureParser.cpp parser.cpp \
@@ -39,6 +48,24 @@ semiexpression.cpp tokenizer.cpp /link setargv.obj
 
 Maintenance History:
 ====================
+ver 2.9 : 18 Oct 2026
+- Attach() maps files into memory, so the Toker lexes a buffer, and
+  reads the file as a stream only if it can't be mapped
+ver 2.8 : 18 Oct 2026
+- Attach() inflates *.gz files only in builds with BYTESOURCE_ZLIB,
+  other builds read them as before
+ver 2.7 : 18 Oct 2026
+- added attachError(), which says why Attach() failed, e.g., a *.gz
+  file in a build without zlib, or a .gz file found truncated
+ver 2.6 : 18 Oct 2026
+- the SemiExp reads a TokenTee, so other clients can share the tokens
+  the parser lexes, with addTokenConsumer() and addTokenQueue()
+ver 2.4 : 18 Oct 2026
+- Attach() streams files named *.gz through a GzipByteSource
+ver 2.3 : 18 Oct 2026
+- Attach() reuses one ifstream and resets the SemiExp and Repository,
+  so the parts built once can parse file after file
+- pointers start null and the destructor releases every rule and action
 ver 2.2 : 14 Mar 16
 - Added treeWalk function and showComptable
 ver 2.1 : 19 Feb 16
@@ -55,9 +82,13 @@ ver 1.0 : 12 Jan 06
 
 //
 #include <fstream>
+#include <memory>
 #include "Parser.h"
 #include "../SemiExp/SemiExp.h"
 #include "../Tokenizer/Tokenizer.h"
+#include "../Tokenizer/ByteSource.h"
+#include "../Tokenizer/MappedFile.h"
+#include "../Tokenizer/TokenTee.h"
 #include "ActionsAndRules.h"
 #include "../AST/Ast.h"
 
@@ -70,45 +101,52 @@ public:
   ConfigParseToConsole() {};
   ~ConfigParseToConsole();
   bool Attach(const std::string& name, bool isFile=true);
+  std::string attachError();
   Parser* Build();
   Parser* Build2();
   void treeWalk();
   void showComtable();
+  void addTokenConsumer(Scanner::ITokenConsumer* pConsumer);
+  std::shared_ptr<Scanner::TokenQueue> addTokenQueue(size_t maxBatches = 4);
 
 private:
   // Builder must hold onto all the pieces
 
-  std::ifstream* pIn;
-  Scanner::Toker* pToker;
-  Scanner::SemiExp* pSemi;
-  Parser* pParser;
-  Repository* pRepo;
+  std::ifstream in;
+  Scanner::MappedFile mapped;
+  std::unique_ptr<Scanner::GzipByteSource> pGzSource;
+  std::string errorText;          // why the last Attach() failed
+  Scanner::Toker* pToker = nullptr;
+  Scanner::TokenTee* pTee = nullptr;
+  Scanner::SemiExp* pSemi = nullptr;
+  Parser* pParser = nullptr;
+  Repository* pRepo = nullptr;
  // Ast* pAst;
 
   // add Rules and Actions
 
-  BeginningOfScope* pBeginningOfScope;
-  HandlePush* pHandlePush;
-  EndOfScope* pEndOfScope;
-  HandlePop* pHandlePop;
-  FunctionDefinition* pFunctionDefinition;
-  PushFunction* pPushFunction;
-  PrintFunction* pPrintFunction;
-  Declaration* pDeclaration;
-  ShowDeclaration* pShowDeclaration;
-  Executable* pExecutable;
-  ShowExecutable* pShowExecutable;
-  PreprocStatement* pPreprocStatement;
-  PrintPreproc* pPrintPreproc;
-  Loop *pLoop;
-  pushLoop *ppushLoop;
-  PrintLoop *pPrintLoop;
-  ClassStruct* pClassStruct;
-  pushClassStruct* ppushClassStruct;
-  showClassStruct* pshowClassStruct;
-  lambda* pLambda;
-  PushLambda* pPushLambda;
-  showLambda* pShowLambda;
+  BeginningOfScope* pBeginningOfScope = nullptr;
+  HandlePush* pHandlePush = nullptr;
+  EndOfScope* pEndOfScope = nullptr;
+  HandlePop* pHandlePop = nullptr;
+  FunctionDefinition* pFunctionDefinition = nullptr;
+  PushFunction* pPushFunction = nullptr;
+  PrintFunction* pPrintFunction = nullptr;
+  Declaration* pDeclaration = nullptr;
+  ShowDeclaration* pShowDeclaration = nullptr;
+  Executable* pExecutable = nullptr;
+  ShowExecutable* pShowExecutable = nullptr;
+  PreprocStatement* pPreprocStatement = nullptr;
+  PrintPreproc* pPrintPreproc = nullptr;
+  Loop* pLoop = nullptr;
+  pushLoop* ppushLoop = nullptr;
+  PrintLoop* pPrintLoop = nullptr;
+  ClassStruct* pClassStruct = nullptr;
+  pushClassStruct* ppushClassStruct = nullptr;
+  showClassStruct* pshowClassStruct = nullptr;
+  lambda* pLambda = nullptr;
+  PushLambda* pPushLambda = nullptr;
+  showLambda* pShowLambda = nullptr;
   // prohibit copies and assignments
 
   ConfigParseToConsole(const ConfigParseToConsole&) = delete;
@@ -157,7 +157,7 @@ if(argc < 2)
       {
         if(!configure.Attach(argv[i]))
         {
-          std::cout << "\n  could not open file " << fileSpec << std::endl;
+          std::cout << "\n  could not open file " << fileSpec << ": " << configure.attachError() << std::endl;
           continue;
         }
       }
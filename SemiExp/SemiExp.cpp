@@ -1,6 +1,6 @@
 ///////////////////////////////////////////////////////////////////////////////
 // SemiExp.cpp - collect tokens for analysis                                 //
-// ver 3.5                                                                   //
+// ver 4.3                                                                   //
 // Language:    C++, Visual Studio 2015                                      //
 // Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
 //              Alienware R15, Core i5, Windows 10                           //
@@ -35,6 +35,28 @@
 *
 * Maintenance History:
 * --------------------
+* ver 4.3 : 18 Oct 2026
+* - reads from an ITokenSource, so it can share a TokenTee's batches
+* ver 4.2 : 18 Oct 2026
+* - a directive token, from Toker::returnDirectives(), is a whole
+*   semiExpression when it starts one
+* ver 4.1 : 18 Oct 2026
+* - added isComment(n)
+* ver 4.0 : 18 Oct 2026
+* - added reset()
+* ver 3.9 : 18 Oct 2026
+* - currentLineCount() is the line of the last token collected, found
+*   from its offset, instead of the Toker's count less one
+* ver 3.8 : 18 Oct 2026
+* - collects tokens from Toker::getToks() in batches, and reports the
+*   line count recorded with the last token used
+* ver 3.7 : 18 Oct 2026
+* - added id(n) and find(id), which use TokenIds interned in the global
+*   TokenTable, so clients can compare tokens as integers
+* ver 3.6 : 18 Oct 2026
+* - keeps the TokenKind Toker assigned to each token, available from
+*   kind(n).  trimFront() and the terminator tests use kinds instead
+*   of comparing token text.
 * ver 3.5 : 15 Feb 2016
 * - modifications to implement ITokCollection:
 *   - added member functions: const indexer, push_back, remove(tok),
@@ -80,9 +102,14 @@
 using namespace Scanner;
 using Token = std::string;
 
+namespace
+{
+  const size_t batchSize = 64;   // tokens read from Toker per call
+}
+
 //----< initialize semiExpression with existing toker reference >----
 
-SemiExp::SemiExp(Toker* pToker) : _pToker(pToker) {}
+SemiExp::SemiExp(ITokenSource* pToker) : _pToker(pToker) {}
 
 //----< returns position of tok in semiExpression >------------------
 
@@ -93,11 +120,64 @@ size_t SemiExp::find(const std::string& tok)
       return i;
   return length();
 }
+//----< returns position of first token with this id >---------------
+
+size_t SemiExp::find(TokenId id)
+{
+  for (size_t i = 0; i < length(); ++i)
+    if (this->id(i) == id)
+      return i;
+  return length();
+}
 //----< push token onto back end of SemiExp >------------------------
 
 void SemiExp::push_back(const std::string& tok)
 {
   _tokens.push_back(tok);
+  _kinds.push_back(classifyToken(tok));
+}
+//----< push token of known kind onto back end of SemiExp >----------
+
+void SemiExp::push_back(const std::string& tok, TokenKind kind)
+{
+  _tokens.push_back(tok);
+  _kinds.push_back(kind);
+}
+//----< kind of nth token, as assigned when it was collected >-------
+
+TokenKind SemiExp::kind(size_t n)
+{
+  if (n >= _kinds.size())
+    throw(std::invalid_argument("index out of range"));
+  return _kinds[n];
+}
+//----< interned id of nth token, Tok::none if it has none >---------
+/*
+ *  Ids are interned on first use, not as tokens are collected, and
+ *  _ids holds the ids of a prefix of _tokens.  Anything that might
+ *  change a token truncates _ids, so its id is interned again.
+ */
+TokenId SemiExp::id(size_t n)
+{
+  if (n >= _tokens.size())
+    throw(std::invalid_argument("index out of range"));
+  while (_ids.size() <= n)
+  {
+    size_t i = _ids.size();
+    switch (_kinds[i])
+    {
+    case TokenKind::comment:
+    case TokenKind::stringLiteral:
+    case TokenKind::charLiteral:
+    case TokenKind::number:
+    case TokenKind::directive:
+      _ids.push_back(Tok::none);    // not worth a table entry
+      break;
+    default:
+      _ids.push_back(TokenTable::global().intern(_tokens[i]));
+    }
+  }
+  return _ids[n];
 }
 //----< removes token passed as argument >---------------------------
 
@@ -108,6 +188,10 @@ bool SemiExp::remove(const std::string& tok)
   {
     if (tok == *iter)
     {
+      size_t n = iter - _tokens.begin();
+      _kinds.erase(_kinds.begin() + n);
+      if (n < _ids.size())
+        _ids.erase(_ids.begin() + n);
       _tokens.erase(iter);
       return true;
     }
@@ -123,6 +207,9 @@ bool SemiExp::remove(size_t n)
     return false;
   std::vector<Token>::iterator iter = _tokens.begin() + n;
   _tokens.erase(iter);
+  _kinds.erase(_kinds.begin() + n);
+  if (n < _ids.size())
+    _ids.erase(_ids.begin() + n);
   return true;
 }
 //----< removes newlines from front of semiExpression >--------------
@@ -131,7 +218,7 @@ void SemiExp::trimFront()
 {
   while (length() > 1)
   {
-    if (_tokens[0] == "\n")
+    if (_kinds[0] == TokenKind::newline)
       remove(0);
     else
       break;
@@ -141,6 +228,7 @@ void SemiExp::trimFront()
 
 void SemiExp::toLower()
 {
+  _ids.clear();
   for (auto& token : _tokens)
   {
     for (auto& chr : token)
@@ -154,24 +242,41 @@ void SemiExp::toLower()
 void SemiExp::clear()
 {
   _tokens.clear();
+  _kinds.clear();
+  _ids.clear();
+}
+//----< forget tokens read ahead, before Toker is reattached >-------
+/*
+ * Keeps the capacity of the token vectors and the batch, so parsing
+ * another file doesn't allocate them again.
+ */
+void SemiExp::reset()
+{
+  clear();
+  _batch.clear();
+  _batchPos = 0;
+  _lastTokenOffset = 0;
+  _hasLastToken = false;
 }
 //----< is this token a comment? >-----------------------------------
 
 bool SemiExp::isComment(const std::string& tok)
 {
-  return _pToker->isComment(tok);
+  return classifyToken(tok) == TokenKind::comment;
+}
+//----< is the nth token a comment? >--------------------------------
+
+bool SemiExp::isComment(size_t n)
+{
+  return n < _kinds.size() && _kinds[n] == TokenKind::comment;
 }
 //----< return count of newlines retrieved by Toker >----------------
 
 size_t SemiExp::currentLineCount()
 {
-  if (_pToker == nullptr)
+  if (_pToker == nullptr || !_hasLastToken)
     return 0;
-  /* 
-   *  Tokenizer has collected first non-state char when exiting eatChars()
-   *  so we need to subtract 1 from the Toker's line count.
-   */
-  return _pToker->currentLineCount() - 1;
+  return _pToker->lineOf(_lastTokenOffset);
 }
 //----< helps folding for expressions >------------------------------
 
@@ -200,31 +305,43 @@ bool SemiExp::get(bool clear)
 }
 //----< is token a SemiExpression terminator? >----------------------
 
-bool SemiExp::isTerminator(const std::string& token)
+bool SemiExp::isTerminator(const std::string& token, TokenKind kind)
 {
-  if (token == "{" || token == "}" || token == ";")
-    return true;
-
-  if (token == "\n")
+  if (kind == TokenKind::newline)
   {
     trimFront();
-    if (_tokens[0] == "#")
-      return true;
+    return _kinds[0] == TokenKind::preprocHash;
+  }
+  if (kind == TokenKind::directive)
+  {
+    trimFront();
+    return _kinds[0] == TokenKind::directive;
   }
 
-  if (length() < 2)
+  if (kind != TokenKind::punctuator || token.size() != 1)
     return false;
 
-  if (token == ":" && length() > 0 && _tokens[length() - 2] == "public")
-    return true;
-
-  if (token == ":" && length() > 0 && _tokens[length() - 2] == "protected")
-    return true;
-
-  if (token == ":" && length() > 0 && _tokens[length() - 2] == "private")
+  switch (fixedId(token))
+  {
+  case Tok::lbrace:
+  case Tok::rbrace:
+  case Tok::semicolon:
     return true;
-
-  return false;
+  case Tok::colon:
+    if (length() < 2 || _kinds[length() - 2] != TokenKind::keyword)
+      return false;
+    switch (fixedId(_tokens[length() - 2]))
+    {
+    case Tok::kw_public:
+    case Tok::kw_protected:
+    case Tok::kw_private:
+      return true;
+    default:
+      return false;
+    }
+  default:
+    return false;
+  }
 }
 //----< does all the work of collecting tokens for collection >------
 
@@ -234,18 +351,27 @@ bool SemiExp::getHelper(bool clear)
   if (_pToker == nullptr)
     throw(std::logic_error("no Toker reference"));
   if(clear)
-    _tokens.clear();
+    this->clear();
   while (true)
   {
-    std::string token = _pToker->getTok();
-    if (token == "")
-      break;
-    _tokens.push_back(token);
-
-    if (token == "for")
+    if (_batchPos == _batch.size())
+    {
+      _batchPos = 0;
+      if (_pToker->getToks(_batch, batchSize) == 0)
+        break;
+    }
+    TokenRecord record = _batch[_batchPos];
+    _lastTokenOffset = record.offset();
+    _hasLastToken = true;
+    ++_batchPos;
+    _tokens.push_back(record.text.str());
+    _kinds.push_back(record.kind);
+    const std::string& token = _tokens.back();
+
+    if (record.kind == TokenKind::keyword && fixedId(token) == Tok::kw_for)
       hasFor = true;
     
-    if (isTerminator(token))
+    if (isTerminator(token, record.kind))
       return true;
   }
   return false;
@@ -264,6 +390,8 @@ Token& SemiExp::operator[](size_t n)
 {
   if (n < 0 || n >= _tokens.size())
     throw(std::invalid_argument("index out of range"));
+  if (n < _ids.size())
+    _ids.resize(n);      // caller may change the token
   return _tokens[n];
 }
 //----< return number of tokens in semiExpression >------------------
@@ -2,7 +2,7 @@
 #define SEMIEXPRESSION_H
 ///////////////////////////////////////////////////////////////////////////////
 // SemiExp.h - collect tokens for analysis                                 //
-// ver 3.5                                                                   //
+// ver 4.3                                                                   //
 // Language:    C++, Visual Studio 2015                                      //
 // Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
 //              Alienware R15, Core i5, Windows 10                           //
@@ -25,7 +25,16 @@
 * Each semiexpression returns just the right tokens to analyze one
 * C++ grammatical construct, e.g., class definition, function definition,
 * declaration, etc.
+*
+* SemiExp reads tokens from its Toker in batches, so the Toker is
+* usually ahead of the SemiExp.  Use SemiExp::currentLineCount(), the
+* line of the last token collected, not the Toker's, while parsing.
 * 
+* Call reset() before reattaching its Toker to another input.
+*
+* The Toker may be any ITokenSource, e.g., a TokenTee that passes each
+* batch on to other clients too, so the input is lexed only once.
+*
 * Build Process:
 * --------------
 * Required Files: 
@@ -36,6 +45,30 @@
 *
 * Maintenance History:
 * --------------------
+* ver 4.3 : 18 Oct 2026
+* - reads from an ITokenSource, a Toker or a TokenTee
+* ver 4.2 : 18 Oct 2026
+* - a directive token, from Toker::returnDirectives(), is a whole
+*   semiExpression when it starts one
+* ver 4.1 : 18 Oct 2026
+* - added isComment(n), which tests the kind of the nth token instead
+*   of re-inspecting its text
+* ver 4.0 : 18 Oct 2026
+* - added reset(), which discards tokens read ahead so one SemiExp and
+*   Toker can process file after file
+* ver 3.9 : 18 Oct 2026
+* - currentLineCount() is the line of the last token collected, found
+*   from its offset, instead of the Toker's count less one
+* ver 3.8 : 18 Oct 2026
+* - collects tokens from Toker::getToks() in batches, and reports the
+*   line count recorded with the last token used
+* ver 3.7 : 18 Oct 2026
+* - added id(n) and find(id), which use TokenIds interned in the global
+*   TokenTable, so clients can compare tokens as integers
+* ver 3.6 : 18 Oct 2026
+* - keeps the TokenKind Toker assigned to each token, available from
+*   kind(n).  trimFront() and the terminator tests use kinds instead
+*   of comparing token text.
 * ver 3.5 : 15 Feb 2016
 * - modifications to implement ITokCollection:
 *   - added member functions: const indexer, push_back, remove(tok), 
@@ -71,6 +104,7 @@
 #include <vector>
 #include <string>
 #include "../Tokenizer/Tokenizer.h"
+#include "../Tokenizer/TokenTable.h"
 #include "../SemiExp/itokcollection.h"
 
 namespace Scanner
@@ -78,7 +112,7 @@ namespace Scanner
   class SemiExp : public ITokCollection
   {
   public:
-    SemiExp(Toker* pToker = nullptr);
+    SemiExp(ITokenSource* pToker = nullptr);
     SemiExp(const SemiExp&) = delete;
     SemiExp& operator=(const SemiExp&) = delete;
     bool get(bool clear = true);
@@ -86,22 +120,34 @@ namespace Scanner
     std::string operator[](size_t n) const;
     size_t length();
     size_t find(const std::string& tok);
+    size_t find(TokenId id);
     void trimFront();
     void toLower();
     bool remove(const std::string& tok);
     bool remove(size_t n);
     void push_back(const std::string& tok);
+    void push_back(const std::string& tok, TokenKind kind);
+    TokenKind kind(size_t n);
+    TokenId id(size_t n);
     void clear();
+    void reset();
     bool isComment(const std::string& tok);
+    bool isComment(size_t n);
     std::string show(bool showNewLines = false);
     size_t currentLineCount();
   private:
-    bool isTerminator(const std::string& tok);
+    bool isTerminator(const std::string& tok, TokenKind kind);
     bool getHelper(bool clear = false);
     bool isSemiColonBetweenParens();
     bool hasFor = false;
     std::vector<std::string> _tokens;
-    Toker* _pToker;
+    std::vector<TokenKind> _kinds;     // parallel to _tokens
+    std::vector<TokenId> _ids;         // ids of a prefix of _tokens
+    TokenBuffer _batch;                // tokens read ahead from Toker
+    size_t _batchPos = 0;              // next token in _batch to use
+    size_t _lastTokenOffset = 0;       // input offset of last token used
+    bool _hasLastToken = false;
+    ITokenSource* _pToker;
   };
 }
 #endif
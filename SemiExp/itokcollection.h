@@ -2,7 +2,7 @@
 #define ITOKCOLLECTION_H
 ///////////////////////////////////////////////////////////////////////////////
 //  ITokCollection.h - package for the ITokCollection interface              //
-//  ver 1.2                                                                  //
+//  ver 1.4                                                                  //
 // Language:    C++, Visual Studio 2015                                      //
 // Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
 //              Alienware R15, Core i5, Windows 10                           //
@@ -22,6 +22,10 @@
 
   Maintenance History:
   ====================
+  ver 1.4 : 18 Oct 2026
+  - added id(n) and find(id), for integer compares of interned tokens
+  ver 1.3 : 18 Oct 2026
+  - added kind(n), the TokenKind Toker assigned to the nth token
   ver 1.2 : 15 Feb 2016
   - removed merge, added non-const operator[] overload
   ver 1.1 : 02 Jun 11
@@ -30,6 +34,8 @@
   - first release
 */
 #include <string> 
+#include "../Tokenizer/Tokenizer.h"
+#include "../Tokenizer/TokenTable.h"
 
 struct ITokCollection
 {
@@ -38,6 +44,7 @@ struct ITokCollection
   virtual std::string& operator[](size_t n) = 0;
   virtual std::string operator[](size_t n) const = 0;
   virtual size_t find(const std::string& tok)=0;
+  virtual size_t find(Scanner::TokenId id)=0;
   virtual void push_back(const std::string& tok)=0;
   virtual bool remove(const std::string& tok)=0;
   virtual bool remove(size_t i)=0;
@@ -46,6 +53,8 @@ struct ITokCollection
   virtual void clear()=0;
   virtual std::string show(bool showNewLines=false)=0;
   virtual bool isComment(const std::string& tok) = 0;
+  virtual Scanner::TokenKind kind(size_t n) = 0;
+  virtual Scanner::TokenId id(size_t n) = 0;
   virtual ~ITokCollection() {};
 };
 
@@ -0,0 +1,318 @@
+///////////////////////////////////////////////////////////////////////////////
+// ByteSource.cpp - sources of bytes for a streaming Toker                   //
+// ver 1.3                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* GzipByteSource's thread reads the compressed file in blocks, inflates
+* them with zlib, and queues the inflated blocks.  At most maxBlocks
+* wait in the queue, so memory stays bounded when the Toker is slower.
+* read() copies from the front block, waiting only when the queue is
+* empty.  Concatenated gzip members are inflated in turn, like gunzip.
+*
+* Build Process:
+* --------------
+* Required Files: ByteSource.h, ByteSource.cpp, and zlib with BYTESOURCE_ZLIB
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.3 : 18 Oct 2026
+* - GzipByteSource ignores bytes after the last member, as gzip -d does
+* ver 1.2 : 18 Oct 2026
+* - GzipByteSource's constructors don't warn of unused parameters
+*   when built without zlib
+* ver 1.1 : 18 Oct 2026
+* - added GzipByteSource
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include "ByteSource.h"
+
+#ifdef BYTESOURCE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace Scanner;
+
+namespace
+{
+  FILE* openBinary(const std::string& fileSpec)
+  {
+#ifdef _MSC_VER
+    FILE* pFile;
+    if (fopen_s(&pFile, fileSpec.c_str(), "rb") != 0)
+      return nullptr;
+    return pFile;
+#else
+    return std::fopen(fileSpec.c_str(), "rb");
+#endif
+  }
+}
+
+//----< read up to max bytes from the stream >-----------------------
+
+size_t StreamByteSource::read(char* pDest, size_t max)
+{
+  if (!_in.good())
+    return 0;
+  _in.read(pDest, static_cast<std::streamsize>(max));
+  return static_cast<size_t>(_in.gcount());
+}
+//----< open file for binary reading >-------------------------------
+
+FileByteSource::FileByteSource(const std::string& fileSpec)
+  : _pFile(openBinary(fileSpec)), _owner(true) {}
+//----< read from a file opened by the caller >----------------------
+
+FileByteSource::FileByteSource(FILE* pFile) : _pFile(pFile), _owner(false) {}
+
+FileByteSource::~FileByteSource()
+{
+  if (_owner && _pFile != nullptr)
+    std::fclose(_pFile);
+}
+//----< read up to max bytes, 0 at end of file >---------------------
+
+size_t FileByteSource::read(char* pDest, size_t max)
+{
+  if (_pFile == nullptr)
+    return 0;
+  return std::fread(pDest, 1, max, _pFile);
+}
+//----< open compressed file and start inflating it >---------------
+
+GzipByteSource::GzipByteSource(const std::string& fileSpec, size_t blockSize, size_t maxBlocks)
+  : _owner(true), _blockSize(std::max<size_t>(blockSize, 1)), _maxBlocks(std::max<size_t>(maxBlocks, 1))
+{
+#ifdef BYTESOURCE_ZLIB
+  _pFile = openBinary(fileSpec);
+  if (_pFile == nullptr)
+    _error = "can't open " + fileSpec;
+#else
+  (void)fileSpec;
+#endif
+  start();
+}
+//----< inflate a file opened by the caller >------------------------
+
+GzipByteSource::GzipByteSource(FILE* pFile, size_t blockSize, size_t maxBlocks)
+  : _owner(false), _blockSize(std::max<size_t>(blockSize, 1)), _maxBlocks(std::max<size_t>(maxBlocks, 1))
+{
+#ifdef BYTESOURCE_ZLIB
+  _pFile = pFile;
+#else
+  (void)pFile;
+#endif
+  start();
+}
+//----< start the inflating thread, or report why there is none >---
+
+void GzipByteSource::start()
+{
+#ifdef BYTESOURCE_ZLIB
+  if (_pFile != nullptr)
+    _inflater = std::thread(&GzipByteSource::inflateBlocks, this);
+  else
+    _finished = true;
+#else
+  _error = "GzipByteSource needs zlib: build with BYTESOURCE_ZLIB";
+  _finished = true;
+#endif
+}
+//----< stop the thread, even if its blocks were never read >-------
+
+GzipByteSource::~GzipByteSource()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopping = true;
+  }
+  _canWrite.notify_all();
+  if (_inflater.joinable())
+    _inflater.join();
+  if (_owner && _pFile != nullptr)
+    std::fclose(_pFile);
+}
+//----< copy up to max inflated bytes, 0 at end of input >----------
+
+size_t GzipByteSource::read(char* pDest, size_t max)
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _canRead.wait(lock, [this] { return !_blocks.empty() || _finished; });
+  if (_blocks.empty())
+    return 0;
+  std::vector<char>& block = _blocks.front();
+  size_t count = std::min(max, block.size() - _frontPos);
+  std::memcpy(pDest, block.data() + _frontPos, count);
+  _frontPos += count;
+  if (_frontPos == block.size())
+  {
+    _blocks.pop_front();
+    _frontPos = 0;
+    lock.unlock();
+    _canWrite.notify_one();
+  }
+  return count;
+}
+//----< why input ended early, empty if it didn't >------------------
+
+std::string GzipByteSource::error()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _error;
+}
+//----< queue an inflated block, false if the source is closing >----
+
+bool GzipByteSource::push(std::vector<char>& block)
+{
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _canWrite.wait(lock, [this] { return _blocks.size() < _maxBlocks || _stopping; });
+    if (_stopping)
+      return false;
+    _blocks.push_back(std::move(block));
+  }
+  _canRead.notify_one();
+  block.assign(_blockSize, '\0');
+  return true;
+}
+//----< tell read() there are no more blocks >----------------------
+
+void GzipByteSource::finish(const std::string& error)
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _error = error;
+    _finished = true;
+  }
+  _canRead.notify_all();
+}
+//----< inflating thread: file blocks in, inflated blocks out >------
+/*
+ * windowBits 15 + 32 accepts gzip and zlib headers.  When a member
+ * ends and more input follows, the stream is reset for the next one.
+ * Like gzip -d, bytes after the last member that don't begin another
+ * one, e.g., padding, are ignored.
+ */
+void GzipByteSource::inflateBlocks()
+{
+#ifdef BYTESOURCE_ZLIB
+  z_stream zs;
+  std::memset(&zs, 0, sizeof(zs));
+  if (inflateInit2(&zs, 15 + 32) != Z_OK)
+  {
+    finish("zlib initialization failed");
+    return;
+  }
+  std::vector<unsigned char> input(_blockSize);
+  std::vector<char> block(_blockSize);
+  size_t filled = 0;
+  int result = Z_OK;
+  bool memberEnded = false;           // at least one member is complete
+  std::string error;
+  while (true)
+  {
+    if (zs.avail_in == 0)
+    {
+      size_t count = std::fread(input.data(), 1, input.size(), _pFile);
+      if (count == 0)
+      {
+        if (result != Z_STREAM_END && !(memberEnded && zs.total_out == 0))
+          error = std::ferror(_pFile) ? "error reading compressed file" : "compressed data is truncated";
+        break;
+      }
+      zs.next_in = input.data();
+      zs.avail_in = static_cast<uInt>(count);
+    }
+    if (result == Z_STREAM_END)
+    {
+      memberEnded = true;
+      inflateReset(&zs);
+    }
+    zs.next_out = reinterpret_cast<Bytef*>(block.data() + filled);
+    zs.avail_out = static_cast<uInt>(block.size() - filled);
+    result = inflate(&zs, Z_NO_FLUSH);
+    if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+    {
+      if (memberEnded && zs.total_out == 0)
+        break;                        // trailing bytes, not a member
+      error = zs.msg != nullptr ? zs.msg : "compressed data is corrupt";
+      break;
+    }
+    filled = block.size() - zs.avail_out;
+    if (filled == block.size())
+    {
+      if (!push(block))
+        break;
+      filled = 0;
+    }
+  }
+  inflateEnd(&zs);
+  if (filled > 0)
+  {
+    block.resize(filled);
+    push(block);
+  }
+  finish(error);
+#endif
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_BYTESOURCE
+
+#include <iostream>
+#include <sstream>
+#include "../Utilities/Utilities.h"
+
+int main(int argc, char* argv[])
+{
+  Utilities::StringHelper::Title("Testing ByteSource");
+
+  std::istringstream in("a stream of bytes read in small blocks");
+  StreamByteSource streamSource(in);
+  char block[8];
+  size_t count;
+  std::cout << "\n  ";
+  while ((count = streamSource.read(block, sizeof(block))) > 0)
+    std::cout << "[" << std::string(block, count) << "]";
+
+  std::string fileSpec = argc > 1 ? argv[1] : "../Tokenizer/ByteSource.cpp";
+  FileByteSource fileSource(fileSpec);
+  if (!fileSource.isOpen())
+  {
+    std::cout << "\n  can't open " << fileSpec << "\n\n";
+    return 1;
+  }
+  size_t total = 0;
+  char buffer[4096];
+  while ((count = fileSource.read(buffer, sizeof(buffer))) > 0)
+    total += count;
+  std::cout << "\n  read " << total << " bytes from " << fileSpec;
+
+  if (argc > 2)
+  {
+    GzipByteSource gzSource(argv[2], 4096);
+    total = 0;
+    while ((count = gzSource.read(buffer, sizeof(buffer))) > 0)
+      total += count;
+    std::cout << "\n  inflated " << total << " bytes from " << argv[2];
+    if (gzSource.error().size() > 0)
+      std::cout << ", " << gzSource.error();
+  }
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
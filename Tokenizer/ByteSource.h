@@ -0,0 +1,131 @@
+#ifndef BYTESOURCE_H
+#define BYTESOURCE_H
+///////////////////////////////////////////////////////////////////////////////
+// ByteSource.h - sources of bytes for a streaming Toker                     //
+// ver 1.1                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides the IByteSource interface, which Toker reads in
+* blocks through its fixed size window, and two implementations:
+* - StreamByteSource reads a std::istream, e.g., a socket or a
+*   decompressing stream
+* - FileByteSource reads a file, or an open FILE* like stdin, with
+*   fread, so a pipe or a file too large to map can be tokenized
+*   in bounded memory
+* - GzipByteSource inflates a gzip or zlib file on its own thread,
+*   a few blocks ahead of the Toker, so decompression overlaps lexing.
+*   Toker sees only the inflated text, so its lines and offsets are
+*   those of the uncompressed source.
+* read() returns the number of bytes it put in pDest, 0 only at the
+* end of input.
+*
+* GzipByteSource needs zlib, and is built only when BYTESOURCE_ZLIB is
+* defined and zlib is linked.  Otherwise it never opens, and error()
+* says why, so callers can fall back to decompressing first.
+*
+* Public Interface:
+* -----------------
+* FileByteSource source(stdin);
+* Toker toker;
+* toker.attach(&source, 64 * 1024);
+* GzipByteSource gzSource("snapshot/Parser.cpp.gz");
+* if (gzSource.isOpen())
+*   toker.attach(&gzSource);
+* if (gzSource.error().size() > 0)
+*   std::cout << gzSource.error();      // after read() returned 0
+*
+* Build Process:
+* --------------
+* Required Files: ByteSource.h, ByteSource.cpp, and zlib with BYTESOURCE_ZLIB
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 18 Oct 2026
+* - added GzipByteSource, which streams a compressed file
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Scanner
+{
+  class IByteSource
+  {
+  public:
+    virtual ~IByteSource() {}
+    virtual size_t read(char* pDest, size_t max) = 0;
+  };
+
+  class StreamByteSource : public IByteSource
+  {
+  public:
+    StreamByteSource(std::istream& in) : _in(in) {}
+    size_t read(char* pDest, size_t max) override;
+  private:
+    std::istream& _in;
+  };
+
+  class FileByteSource : public IByteSource
+  {
+  public:
+    FileByteSource(const std::string& fileSpec);
+    FileByteSource(FILE* pFile);   // not closed by the destructor
+    FileByteSource(const FileByteSource&) = delete;
+    FileByteSource& operator=(const FileByteSource&) = delete;
+    ~FileByteSource();
+    bool isOpen() const { return _pFile != nullptr; }
+    size_t read(char* pDest, size_t max) override;
+  private:
+    FILE* _pFile;
+    bool _owner;
+  };
+
+  class GzipByteSource : public IByteSource
+  {
+  public:
+    static const size_t defaultBlockSize = 64 * 1024;
+    GzipByteSource(const std::string& fileSpec, size_t blockSize = defaultBlockSize, size_t maxBlocks = 4);
+    GzipByteSource(FILE* pFile, size_t blockSize = defaultBlockSize, size_t maxBlocks = 4);   // not closed
+    GzipByteSource(const GzipByteSource&) = delete;
+    GzipByteSource& operator=(const GzipByteSource&) = delete;
+    ~GzipByteSource();
+    bool isOpen() const { return _pFile != nullptr; }
+    size_t read(char* pDest, size_t max) override;
+    std::string error();
+  private:
+    void start();
+    void inflateBlocks();
+    bool push(std::vector<char>& block);
+    void finish(const std::string& error);
+    FILE* _pFile = nullptr;
+    bool _owner;
+    size_t _blockSize;
+    size_t _maxBlocks;
+    std::deque<std::vector<char>> _blocks;   // inflated, not yet read
+    size_t _frontPos = 0;                    // bytes of _blocks.front() read
+    bool _finished = false;
+    bool _stopping = false;
+    std::string _error;
+    std::mutex _mutex;
+    std::condition_variable _canRead;
+    std::condition_variable _canWrite;
+    std::thread _inflater;
+  };
+}
+#endif
@@ -0,0 +1,897 @@
+///////////////////////////////////////////////////////////////////////////////
+// CharScan.cpp - vectorized scanners for runs of source characters         //
+// ver 1.6                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Each scanner has a scalar, an SSE2, and an AVX2 version.  The vector
+* versions classify a whole block of chars with compares, turn the result
+* into a bit mask with movemask, and find the first interesting char with
+* a bit scan.  They never load past pEnd, so the last partial block is
+* finished by the scalar loop.  That matters for mapped files, where the
+* byte after the buffer may be on an unmapped page.
+*
+* Char classes are computed with unsigned range tests, e.g. a digit is
+* (c - '0') <= 9 as an unsigned byte, and min_epu8(x, 9) == x is the
+* vector form of that test.
+*
+* Build Process:
+* --------------
+* Required Files: CharScan.h, CharScan.cpp
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.6 : 18 Oct 2026
+* - added findSkippedDirective()
+* ver 1.5 : 18 Oct 2026
+* - added DirectiveScan and findDirectiveEnd()
+* ver 1.4 : 18 Oct 2026
+* - added skipNumber() and findRawLiteralEnd()
+* ver 1.3 : 18 Oct 2026
+* - findLiteralEnd() replaces findQuote(), and stops at line ends
+* ver 1.2 : 18 Oct 2026
+* - added skipUtf8()
+* ver 1.1 : 18 Oct 2026
+* - added findDirective()
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include "CharScan.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define CHARSCAN_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(CHARSCAN_SSE2) && (defined(_MSC_VER) || defined(__GNUC__))
+#define CHARSCAN_AVX2
+#include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define CHARSCAN_AVX2_TARGET
+#else
+#define CHARSCAN_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+using namespace Scanner;
+
+namespace
+{
+  //----< scalar char classes, "C" locale semantics >----------------
+
+  inline bool isBlank(unsigned char ch)
+  {
+    return ch == ' ' || (ch != '\n' && static_cast<unsigned char>(ch - '\t') <= 4);
+  }
+
+  inline bool isIdent(unsigned char ch)
+  {
+    return static_cast<unsigned char>((ch | 0x20) - 'a') <= 25 ||
+      static_cast<unsigned char>(ch - '0') <= 9 || ch == '_';
+  }
+
+  //----< index of lowest set bit, mask must not be zero >-----------
+
+  inline unsigned firstBit(unsigned mask)
+  {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+  }
+
+  /////////////////////////////////////////////////////////////////
+  // scalar scanners - also finish the tail of the vector scanners
+
+  const char* skipBlanksScalar(const char* pChar, const char* pEnd)
+  {
+    while (pChar < pEnd && isBlank(static_cast<unsigned char>(*pChar)))
+      ++pChar;
+    return pChar;
+  }
+
+  const char* skipIdentScalar(const char* pChar, const char* pEnd)
+  {
+    while (pChar < pEnd && isIdent(static_cast<unsigned char>(*pChar)))
+      ++pChar;
+    return pChar;
+  }
+
+  const char* findNewlineScalar(const char* pChar, const char* pEnd)
+  {
+    const void* pFound = std::memchr(pChar, '\n', pEnd - pChar);
+    return pFound ? static_cast<const char*>(pFound) : pEnd;
+  }
+
+  const char* findHashScalar(const char* pChar, const char* pEnd)
+  {
+    const void* pFound = std::memchr(pChar, '#', pEnd - pChar);
+    return pFound ? static_cast<const char*>(pFound) : pEnd;
+  }
+
+  const char* findCommentEndScalar(const char* pChar, const char* pEnd)
+  {
+    while (pChar < pEnd)
+    {
+      const void* pFound = std::memchr(pChar, '*', pEnd - pChar);
+      if (pFound == nullptr)
+        return pEnd;
+      const char* pStar = static_cast<const char*>(pFound);
+      if (pStar + 1 == pEnd || pStar[1] == '/')
+        return pStar;
+      pChar = pStar + 1;
+    }
+    return pEnd;
+  }
+
+  const char* findLiteralStopScalar(const char* pChar, const char* pEnd, char quote)
+  {
+    while (pChar < pEnd && *pChar != quote && *pChar != '\\' && *pChar != '\n')
+      ++pChar;
+    return pChar;
+  }
+
+#ifdef CHARSCAN_SSE2
+
+  /////////////////////////////////////////////////////////////////
+  // SSE2 scanners, 16 chars per step
+
+  inline __m128i inRange16(__m128i chars, char low, char width)
+  {
+    __m128i offset = _mm_sub_epi8(chars, _mm_set1_epi8(low));
+    return _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(width)), offset);
+  }
+
+  inline unsigned blankMask16(__m128i chars)
+  {
+    __m128i space = _mm_cmpeq_epi8(chars, _mm_set1_epi8(' '));
+    __m128i control = _mm_andnot_si128(
+      _mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')), inRange16(chars, '\t', 4)
+    );
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(space, control)));
+  }
+
+  inline unsigned identMask16(__m128i chars)
+  {
+    __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    __m128i ident = _mm_or_si128(inRange16(lower, 'a', 25), inRange16(chars, '0', 9));
+    ident = _mm_or_si128(ident, _mm_cmpeq_epi8(chars, _mm_set1_epi8('_')));
+    return static_cast<unsigned>(_mm_movemask_epi8(ident));
+  }
+
+  inline __m128i load16(const char* pChar)
+  {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pChar));
+  }
+
+  const char* skipBlanksSse2(const char* pChar, const char* pEnd)
+  {
+    for (; pEnd - pChar >= 16; pChar += 16)
+    {
+      unsigned stop = ~blankMask16(load16(pChar)) & 0xFFFF;
+      if (stop != 0)
+        return pChar + firstBit(stop);
+    }
+    return skipBlanksScalar(pChar, pEnd);
+  }
+
+  const char* skipIdentSse2(const char* pChar, const char* pEnd)
+  {
+    for (; pEnd - pChar >= 16; pChar += 16)
+    {
+      unsigned stop = ~identMask16(load16(pChar)) & 0xFFFF;
+      if (stop != 0)
+        return pChar + firstBit(stop);
+    }
+    return skipIdentScalar(pChar, pEnd);
+  }
+
+  const char* findNewlineSse2(const char* pChar, const char* pEnd)
+  {
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (; pEnd - pChar >= 16; pChar += 16)
+    {
+      unsigned found = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(load16(pChar), newline)));
+      if (found != 0)
+        return pChar + firstBit(found);
+    }
+    return findNewlineScalar(pChar, pEnd);
+  }
+
+  const char* findHashSse2(const char* pChar, const char* pEnd)
+  {
+    const __m128i hash = _mm_set1_epi8('#');
+    for (; pEnd - pChar >= 16; pChar += 16)
+    {
+      unsigned found = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(load16(pChar), hash)));
+      if (found != 0)
+        return pChar + firstBit(found);
+    }
+    return findHashScalar(pChar, pEnd);
+  }
+
+  // compares each block with itself shifted by one, so it needs 17 chars
+  const char* findCommentEndSse2(const char* pChar, const char* pEnd)
+  {
+    const __m128i star = _mm_set1_epi8('*');
+    const __m128i slash = _mm_set1_epi8('/');
+    for (; pEnd - pChar > 16; pChar += 16)
+    {
+      __m128i stars = _mm_cmpeq_epi8(load16(pChar), star);
+      __m128i slashes = _mm_cmpeq_epi8(load16(pChar + 1), slash);
+      unsigned found = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(stars, slashes)));
+      if (found != 0)
+        return pChar + firstBit(found);
+    }
+    return findCommentEndScalar(pChar, pEnd);
+  }
+
+  const char* findLiteralStopSse2(const char* pChar, const char* pEnd, char quote)
+  {
+    const __m128i quotes = _mm_set1_epi8(quote);
+    const __m128i slashes = _mm_set1_epi8('\\');
+    const __m128i newlines = _mm_set1_epi8('\n');
+    for (; pEnd - pChar >= 16; pChar += 16)
+    {
+      __m128i chars = load16(pChar);
+      __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chars, quotes), _mm_cmpeq_epi8(chars, slashes));
+      hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chars, newlines));
+      unsigned found = static_cast<unsigned>(_mm_movemask_epi8(hits));
+      if (found != 0)
+        return pChar + firstBit(found);
+    }
+    return findLiteralStopScalar(pChar, pEnd, quote);
+  }
+#endif
+
+#ifdef CHARSCAN_AVX2
+
+  /////////////////////////////////////////////////////////////////
+  // AVX2 scanners, 32 chars per step, SSE2 for the remainder
+
+  CHARSCAN_AVX2_TARGET inline __m256i inRange32(__m256i chars, char low, char width)
+  {
+    __m256i offset = _mm256_sub_epi8(chars, _mm256_set1_epi8(low));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8(width)), offset);
+  }
+
+  CHARSCAN_AVX2_TARGET inline __m256i load32(const char* pChar)
+  {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pChar));
+  }
+
+  CHARSCAN_AVX2_TARGET const char* skipBlanksAvx2(const char* pChar, const char* pEnd)
+  {
+    for (; pEnd - pChar >= 32; pChar += 32)
+    {
+      __m256i chars = load32(pChar);
+      __m256i space = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' '));
+      __m256i control = _mm256_andnot_si256(
+        _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\n')), inRange32(chars, '\t', 4)
+      );
+      unsigned stop = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(space, control)));
+      if (stop != 0)
+        return pChar + firstBit(stop);
+    }
+    return skipBlanksSse2(pChar, pEnd);
+  }
+
+  CHARSCAN_AVX2_TARGET const char* skipIdentAvx2(const char* pChar, const char* pEnd)
+  {
+    for (; pEnd - pChar >= 32; pChar += 32)
+    {
+      __m256i chars = load32(pChar);
+      __m256i lower = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+      __m256i ident = _mm256_or_si256(inRange32(lower, 'a', 25), inRange32(chars, '0', 9));
+      ident = _mm256_or_si256(ident, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('_')));
+      unsigned stop = ~static_cast<unsigned>(_mm256_movemask_epi8(ident));
+      if (stop != 0)
+        return pChar + firstBit(stop);
+    }
+    return skipIdentSse2(pChar, pEnd);
+  }
+
+  CHARSCAN_AVX2_TARGET const char* findNewlineAvx2(const char* pChar, const char* pEnd)
+  {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    for (; pEnd - pChar >= 32; pChar += 32)
+    {
+      unsigned found = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(load32(pChar), newline)));
+      if (found != 0)
+        return pChar + firstBit(found);
+    }
+    return findNewlineSse2(pChar, pEnd);
+  }
+
+  CHARSCAN_AVX2_TARGET const char* findHashAvx2(const char* pChar, const char* pEnd)
+  {
+    const __m256i hash = _mm256_set1_epi8('#');
+    for (; pEnd - pChar >= 32; pChar += 32)
+    {
+      unsigned found = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(load32(pChar), hash)));
+      if (found != 0)
+        return pChar + firstBit(found);
+    }
+    return findHashSse2(pChar, pEnd);
+  }
+
+  CHARSCAN_AVX2_TARGET const char* findCommentEndAvx2(const char* pChar, const char* pEnd)
+  {
+    const __m256i star = _mm256_set1_epi8('*');
+    const __m256i slash = _mm256_set1_epi8('/');
+    for (; pEnd - pChar > 32; pChar += 32)
+    {
+      __m256i stars = _mm256_cmpeq_epi8(load32(pChar), star);
+      __m256i slashes = _mm256_cmpeq_epi8(load32(pChar + 1), slash);
+      unsigned found = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(stars, slashes)));
+      if (found != 0)
+        return pChar + firstBit(found);
+    }
+    return findCommentEndSse2(pChar, pEnd);
+  }
+
+  CHARSCAN_AVX2_TARGET const char* findLiteralStopAvx2(const char* pChar, const char* pEnd, char quote)
+  {
+    const __m256i quotes = _mm256_set1_epi8(quote);
+    const __m256i slashes = _mm256_set1_epi8('\\');
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    for (; pEnd - pChar >= 32; pChar += 32)
+    {
+      __m256i chars = load32(pChar);
+      __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(chars, quotes), _mm256_cmpeq_epi8(chars, slashes));
+      hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(chars, newlines));
+      unsigned found = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+      if (found != 0)
+        return pChar + firstBit(found);
+    }
+    return findLiteralStopSse2(pChar, pEnd, quote);
+  }
+
+  //----< does the cpu, and the OS, support AVX2? >------------------
+
+  bool cpuHasAvx2()
+  {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+      return false;
+    __cpuid(info, 1);
+    const int osxsave = 1 << 27;
+    const int avx = 1 << 28;
+    if ((info[2] & osxsave) == 0 || (info[2] & avx) == 0)
+      return false;
+    if ((_xgetbv(0) & 6) != 6)   // OS saves xmm and ymm registers
+      return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+  }
+#endif
+
+  /////////////////////////////////////////////////////////////////
+  // dispatch table, one per level
+
+  struct ScanFunctions
+  {
+    ScanLevel level;
+    const char* (*skipBlanks)(const char*, const char*);
+    const char* (*skipIdent)(const char*, const char*);
+    const char* (*findNewline)(const char*, const char*);
+    const char* (*findCommentEnd)(const char*, const char*);
+    const char* (*findLiteralStop)(const char*, const char*, char);
+    const char* (*findHash)(const char*, const char*);
+  };
+
+  const ScanFunctions scalarFunctions = {
+    ScanLevel::scalar, skipBlanksScalar, skipIdentScalar,
+    findNewlineScalar, findCommentEndScalar, findLiteralStopScalar, findHashScalar
+  };
+#ifdef CHARSCAN_SSE2
+  const ScanFunctions sse2Functions = {
+    ScanLevel::sse2, skipBlanksSse2, skipIdentSse2,
+    findNewlineSse2, findCommentEndSse2, findLiteralStopSse2, findHashSse2
+  };
+#endif
+#ifdef CHARSCAN_AVX2
+  const ScanFunctions avx2Functions = {
+    ScanLevel::avx2, skipBlanksAvx2, skipIdentAvx2,
+    findNewlineAvx2, findCommentEndAvx2, findLiteralStopAvx2, findHashAvx2
+  };
+#endif
+
+  const ScanFunctions& functionsFor(ScanLevel level)
+  {
+#ifdef CHARSCAN_AVX2
+    if (level == ScanLevel::avx2)
+      return avx2Functions;
+#endif
+#ifdef CHARSCAN_SSE2
+    if (level >= ScanLevel::sse2)
+      return sse2Functions;
+#endif
+    return scalarFunctions;
+  }
+
+  // constant initialized, so it is safe to use during static initialization
+  std::atomic<const ScanFunctions*> pSelected(nullptr);
+
+  const ScanFunctions& selected()
+  {
+    const ScanFunctions* pFunctions = pSelected.load(std::memory_order_relaxed);
+    if (pFunctions == nullptr)
+    {
+      pFunctions = &functionsFor(bestScanLevel());
+      pSelected.store(pFunctions, std::memory_order_relaxed);
+    }
+    return *pFunctions;
+  }
+}
+
+//----< skip whitespace other than newline >-------------------------
+
+const char* Scanner::skipBlanks(const char* pBegin, const char* pEnd)
+{
+  if (pBegin < pEnd && !isBlank(static_cast<unsigned char>(*pBegin)))
+    return pBegin;  // most runs are empty or one space
+  return selected().skipBlanks(pBegin, pEnd);
+}
+//----< skip letters, digits, and underscores >----------------------
+
+const char* Scanner::skipIdent(const char* pBegin, const char* pEnd)
+{
+  return selected().skipIdent(pBegin, pEnd);
+}
+//----< find end of line >-------------------------------------------
+
+const char* Scanner::findNewline(const char* pBegin, const char* pEnd)
+{
+  return selected().findNewline(pBegin, pEnd);
+}
+//----< find star of C comment terminator >--------------------------
+
+const char* Scanner::findCommentEnd(const char* pBegin, const char* pEnd)
+{
+  return selected().findCommentEnd(pBegin, pEnd);
+}
+//----< find end of quoted literal, on the line it starts on >------
+/*
+ * Walking forward, each backslash escapes the next char, or the next
+ * "\r\n", so a backslash at the end of a line continues the literal.
+ * That gives the same answer as counting the backslash run before each
+ * quote, in one pass.  Returns the closing quote, or the unescaped
+ * line end, the '\n' or the '\r' of "\r\n", or pEnd.
+ */
+const char* Scanner::findLiteralEnd(const char* pBegin, const char* pEnd, char quote)
+{
+  auto findLiteralStop = selected().findLiteralStop;
+  const char* pChar = pBegin;
+  while (pChar < pEnd)
+  {
+    pChar = findLiteralStop(pChar, pEnd, quote);
+    if (pChar == pEnd || *pChar == quote)
+      return pChar;
+    if (*pChar == '\n')
+      return (pChar > pBegin && pChar[-1] == '\r') ? pChar - 1 : pChar;
+    if (pEnd - pChar < 2)
+      return pEnd;      // backslash is the last char
+    pChar += (pChar[1] == '\r' && pEnd - pChar > 2 && pChar[2] == '\n') ? 3 : 2;
+  }
+  return pEnd;
+}
+//----< end of preprocessing number starting at pBegin >-----------
+/*
+ * pBegin is a digit, or a '.' before one.  A number goes on through
+ * letters, digits, and '.', a sign after e, E, p, or P, and a digit
+ * separator, a quote before a letter or digit.  So 0x1Fu, 1.5e-10f,
+ * and 1'000'000 are each one token.  As in C++, so is 0xe+1.
+ */
+const char* Scanner::skipNumber(const char* pBegin, const char* pEnd)
+{
+  const char* pChar = pBegin + 1;
+  while (pChar < pEnd)
+  {
+    int ch = static_cast<unsigned char>(*pChar);
+    int prev = static_cast<unsigned char>(pChar[-1]);
+    if (isIdentChar(ch) || ch == '.')
+      ++pChar;
+    else if ((ch == '+' || ch == '-') && (prev == 'e' || prev == 'E' || prev == 'p' || prev == 'P'))
+      ++pChar;
+    else if (ch == '\'' && pChar + 1 < pEnd && isIdentChar(static_cast<unsigned char>(pChar[1])))
+      pChar += 2;
+    else
+      break;
+  }
+  return pChar;
+}
+//----< end of raw string whose opening quote is at pQuote >---------
+/*
+ * The delimiter is up to maxRawDelimiter chars before the '('.  The
+ * body is searched for ')' with memchr, and each ')' is checked for
+ * the delimiter and closing quote.  complete is false, and the result
+ * is the offending char, if the delimiter is invalid, or pEnd if the
+ * raw string isn't closed.
+ */
+const char* Scanner::findRawLiteralEnd(const char* pQuote, const char* pEnd, bool& complete)
+{
+  complete = false;
+  const char* pDelim = pQuote + 1;
+  const char* pLimit = pDelim + std::min<size_t>(maxRawDelimiter, pEnd - pDelim);
+  const char* pParen = pDelim;
+  while (pParen < pLimit && isRawDelimiterChar(static_cast<unsigned char>(*pParen)))
+    ++pParen;
+  if (pParen == pEnd || *pParen != '(')
+    return pParen;
+  size_t delimSize = pParen - pDelim;
+  const char* pChar = pParen + 1;
+  while (pChar < pEnd)
+  {
+    const void* pFound = std::memchr(pChar, ')', pEnd - pChar);
+    if (pFound == nullptr)
+      return pEnd;
+    const char* pClose = static_cast<const char*>(pFound);
+    if (static_cast<size_t>(pEnd - pClose) >= delimSize + 2 && pClose[delimSize + 1] == '\"'
+      && std::memcmp(pClose + 1, pDelim, delimSize) == 0)
+    {
+      complete = true;
+      return pClose + delimSize + 2;
+    }
+    pChar = pClose + 1;
+  }
+  return pEnd;
+}
+//----< does ch continue the directive? >---------------------------
+/*
+ * A newline ends the directive unless a backslash, maybe followed by
+ * '\r', splices the next line on.  Literals and C comments are taken
+ * whole, so a "//" or newline in them doesn't end it.  Neither does
+ * the newline of an unclosed literal, which, as in the lexers, ends
+ * the literal, not the line.  A "//" outside them does.
+ */
+bool DirectiveScan::takes(int ch, int chNext)
+{
+  bool spliced = _splice;
+  _splice = ch == '\\' || (spliced && ch == '\r');
+  if (_inComment)
+  {
+    if (_opening)
+      _opening = false;
+    else if (_star && ch == '/')
+      _inComment = false;
+    else
+      _star = ch == '*';
+    return true;
+  }
+  if (ch == '\n')
+  {
+    if (!spliced)
+      return false;
+    _escaped = false;
+    return true;
+  }
+  if (_quote != 0)
+  {
+    if (_escaped)
+      _escaped = false;
+    else if (ch == '\\')
+      _escaped = true;
+    else if (ch == _quote)
+      _quote = 0;
+    return true;
+  }
+  if (ch == '\"' || ch == '\'')
+    _quote = ch;
+  else if (ch == '/' && chNext == '/')
+    return false;
+  else if (ch == '/' && chNext == '*')
+  {
+    _inComment = true;
+    _opening = true;
+    _star = false;
+  }
+  return true;
+}
+//----< end of the directive whose '#' is at pHash >-----------------
+/*
+ * pStop is where DirectiveScan stopped: the line end, the first '/'
+ * of a trailing C++ comment, or pEnd.  The result drops the blanks
+ * before pStop, so it is the end of the directive's text.
+ */
+const char* Scanner::findDirectiveEnd(const char* pHash, const char* pEnd, const char*& pStop)
+{
+  DirectiveScan scan;
+  const char* pChar = pHash + 1;
+  for (; pChar < pEnd; ++pChar)
+  {
+    int ch = static_cast<unsigned char>(*pChar);
+    int chNext = ch != '/' ? 0 : (pChar + 1 < pEnd ? static_cast<unsigned char>(pChar[1]) : EOF);
+    if (!scan.takes(ch, chNext))
+      break;
+  }
+  pStop = pChar;
+  while (pChar > pHash + 1 && isBlankChar(static_cast<unsigned char>(pChar[-1])))
+    --pChar;
+  return pChar;
+}
+//----< find '#' that is the first non-blank char of its line >------
+/*
+ * pBegin must be the start of a line.  Candidate '#'s are found a
+ * block at a time, and only those are checked for a line start.
+ */
+const char* Scanner::findDirective(const char* pBegin, const char* pEnd)
+{
+  auto findHash = selected().findHash;
+  const char* pChar = pBegin;
+  while ((pChar = findHash(pChar, pEnd)) < pEnd)
+  {
+    const char* pLineStart = pChar;
+    while (pLineStart > pBegin && isBlank(static_cast<unsigned char>(pLineStart[-1])))
+      --pLineStart;
+    if (pLineStart == pBegin || pLineStart[-1] == '\n')
+      return pChar;
+    ++pChar;
+  }
+  return pEnd;
+}
+//----< find directive line, as translation phase 3 sees the text >-
+/*
+ * Like findDirective(), but walks the text, so a '#' inside a C
+ * comment, a literal, or a raw string, or on a line continued by a
+ * splice, doesn't start a directive.  A literal ends at its line end,
+ * as in the lexers.  pBegin must be outside any comment or literal,
+ * with only blanks before it on its line.  Returns pEnd if a comment
+ * or raw string is still open at the end of input.
+ */
+const char* Scanner::findSkippedDirective(const char* pBegin, const char* pEnd)
+{
+  const char* pChar = pBegin;
+  bool lineStart = true;
+  while (pChar < pEnd)
+  {
+    unsigned char ch = static_cast<unsigned char>(*pChar);
+    if (ch == '\n')
+    {
+      lineStart = true;
+      ++pChar;
+      continue;
+    }
+    if (isBlank(ch))
+    {
+      ++pChar;
+      continue;
+    }
+    if (ch == '#' && lineStart)
+      return pChar;
+    lineStart = false;
+    unsigned char next = pChar + 1 < pEnd ? static_cast<unsigned char>(pChar[1]) : 0;
+    if (ch == '/' && next == '*')
+    {
+      const char* pStar = findCommentEnd(pChar + 2, pEnd);
+      if (pEnd - pStar < 2)
+        return pEnd;
+      pChar = pStar + 2;
+    }
+    else if (ch == '/' && next == '/')
+    {
+      pChar = findNewline(pChar + 2, pEnd);
+      while (pChar < pEnd && (pChar[-1] == '\\' || (pChar[-1] == '\r' && pChar[-2] == '\\')))
+        pChar = findNewline(pChar + 1, pEnd);
+    }
+    else if (ch == '\"' || ch == '\'')
+    {
+      pChar = findLiteralEnd(pChar + 1, pEnd, static_cast<char>(ch));
+      if (pChar < pEnd && *pChar == ch)
+        ++pChar;
+    }
+    else if (ch == '\\' && (next == '\n' || (next == '\r' && pEnd - pChar > 2 && pChar[2] == '\n')))
+      pChar += next == '\n' ? 2 : 3;
+    else if (isDigitChar(ch) || (ch == '.' && isDigitChar(next)))
+      pChar = skipNumber(pChar, pEnd);
+    else if (isIdent(ch))
+    {
+      const char* pWord = pChar;
+      pChar = skipIdent(pChar, pEnd);
+      if (pChar < pEnd && *pChar == '\"' && isRawPrefix(pWord, pChar - pWord))
+      {
+        bool complete;
+        const char* pStop = findRawLiteralEnd(pChar, pEnd, complete);
+        if (!complete && pStop == pEnd)
+          return pEnd;
+        pChar = pStop;
+      }
+    }
+    else
+      ++pChar;
+  }
+  return pEnd;
+}
+//----< skip the valid part of the UTF-8 sequence led by *pLead >---
+/*
+ * *pLead must satisfy isUtf8Lead().  The lead sets the number of
+ * continuation bytes and the range of the first, which excludes
+ * overlong forms, surrogates, and code points above U+10FFFF.
+ * complete is false if a byte out of range, or the end of input,
+ * cuts the sequence short.
+ */
+const char* Scanner::skipUtf8(const char* pLead, const char* pEnd, bool& complete)
+{
+  unsigned char lead = static_cast<unsigned char>(*pLead);
+  size_t remaining = lead < 0xE0 ? 1 : (lead < 0xF0 ? 2 : 3);
+  unsigned char low = 0x80;
+  unsigned char high = 0xBF;
+  if (lead == 0xE0)
+    low = 0xA0;
+  else if (lead == 0xED)
+    high = 0x9F;
+  else if (lead == 0xF0)
+    low = 0x90;
+  else if (lead == 0xF4)
+    high = 0x8F;
+  const char* pChar = pLead + 1;
+  for (; remaining > 0 && pChar < pEnd; --remaining, ++pChar)
+  {
+    unsigned char ch = static_cast<unsigned char>(*pChar);
+    if (ch < low || ch > high)
+      break;
+    low = 0x80;
+    high = 0xBF;
+  }
+  complete = remaining == 0;
+  return pChar;
+}
+//----< best level supported by this build and cpu >-----------------
+
+ScanLevel Scanner::bestScanLevel()
+{
+#ifdef CHARSCAN_AVX2
+  static const bool hasAvx2 = cpuHasAvx2();
+  if (hasAvx2)
+    return ScanLevel::avx2;
+#endif
+#ifdef CHARSCAN_SSE2
+  return ScanLevel::sse2;
+#else
+  return ScanLevel::scalar;
+#endif
+}
+//----< level in use >-----------------------------------------------
+
+ScanLevel Scanner::scanLevel()
+{
+  return selected().level;
+}
+//----< use level, or the best supported level below it >------------
+
+ScanLevel Scanner::setScanLevel(ScanLevel level)
+{
+  if (level > bestScanLevel())
+    level = bestScanLevel();
+  const ScanFunctions& functions = functionsFor(level);
+  pSelected.store(&functions, std::memory_order_relaxed);
+  return functions.level;
+}
+//----< display name of level >--------------------------------------
+
+const char* Scanner::scanLevelName(ScanLevel level)
+{
+  switch (level)
+  {
+  case ScanLevel::avx2:
+    return "avx2";
+  case ScanLevel::sse2:
+    return "sse2";
+  default:
+    return "scalar";
+  }
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_CHARSCAN
+
+#include <iostream>
+#include <string>
+
+int main()
+{
+  std::cout << "\n  Testing CharScan";
+  std::cout << "\n ------------------";
+  std::cout << "\n  best scan level: " << scanLevelName(bestScanLevel());
+
+  std::string text =
+    "   \t  identifier_with_quite_a_long_name_123 = \"a \\\"quoted\\\" string\\\\\";"
+    "  /* a comment that runs on for more than thirty two chars */ x // line\n"
+    "int a = b # c;  // a '#' that is not a directive, and one that is:\n  \t#endif\n";
+  const char* pBegin = text.data();
+  const char* pEnd = pBegin + text.size();
+
+  bool same = true;
+  for (ScanLevel level : { ScanLevel::scalar, ScanLevel::sse2, ScanLevel::avx2 })
+  {
+    ScanLevel used = setScanLevel(level);
+    const char* pIdent = skipBlanks(pBegin, pEnd);
+    const char* pEq = skipIdent(pIdent, pEnd);
+    const char* pQuote = std::strchr(pBegin, '\"');
+    const char* pClose = findLiteralEnd(pQuote + 1, pEnd, '\"');
+    const char* pComment = std::strstr(pBegin, "/*");
+    const char* pStar = findCommentEnd(pComment + 1, pEnd);
+    const char* pNewline = findNewline(pBegin, pEnd);
+    const char* pDirective = findDirective(pBegin, pEnd);
+    std::cout << "\n  " << scanLevelName(used) << ": identifier = "
+      << std::string(pIdent, pEq) << ", string = " << std::string(pQuote, pClose + 1);
+    same = same && std::string(pComment, pStar + 2) ==
+      "/* a comment that runs on for more than thirty two chars */";
+    same = same && pNewline == std::strchr(pBegin, '\n');
+    same = same && std::string(pDirective) == "#endif\n";
+  }
+  std::cout << "\n  comment, newline, and directive found at every level: " << std::boolalpha << same;
+
+  std::string literals = "'unclosed \\\"quote\r\n\"spliced \\\r\nline\" \"over\\\\\" ";
+  for (ScanLevel level : { ScanLevel::scalar, ScanLevel::sse2, ScanLevel::avx2 })
+  {
+    setScanLevel(level);
+    const char* pLit = literals.data();
+    const char* pLitEnd = pLit + literals.size();
+    const char* pLineEnd = findLiteralEnd(pLit + 1, pLitEnd, '\'');
+    const char* pSplice = findLiteralEnd(pLineEnd + 3, pLitEnd, '\"');
+    const char* pOver = findLiteralEnd(pSplice + 3, pLitEnd, '\"');
+    same = same && std::string(pLineEnd, 2) == "\r\n" && std::string(pSplice - 4, 5) == "line\""
+      && pOver == pLitEnd - 2;
+  }
+  setScanLevel(bestScanLevel());
+  std::cout << "\n  literals end at their quote or line end at every level: " << same;
+
+  std::string numbers = "1.5e-10f+0x1Fu 1'000'000;";
+  const char* pNum = skipNumber(numbers.data(), numbers.data() + numbers.size());
+  same = same && std::string(numbers.data(), pNum) == "1.5e-10f";
+  pNum = skipNumber(pNum + 1, numbers.data() + numbers.size());
+  same = same && std::string(pNum + 1) == "1'000'000;"
+    && *skipNumber(pNum + 1, numbers.data() + numbers.size()) == ';';
+  std::string raw = "R\"x(a \")\" )x\" tail";
+  bool complete = false;
+  const char* pRawEnd = findRawLiteralEnd(raw.data() + 1, raw.data() + raw.size(), complete);
+  same = same && complete && std::string(pRawEnd) == " tail";
+  std::cout << "\n  numbers and raw strings end where they should: " << same;
+
+  std::string directive = "#define M(a) \"//\" /* a\n */ a \\\r\n  + 1  // note\nnext";
+  const char* pStop = nullptr;
+  const char* pDirEnd = findDirectiveEnd(directive.data(), directive.data() + directive.size(), pStop);
+  same = same && std::string(directive.data(), pDirEnd) == "#define M(a) \"//\" /* a\n */ a \\\r\n  + 1"
+    && std::string(pStop) == "// note\nnext";
+  std::cout << "\n  directive ends before a trailing comment: " << same;
+
+  std::string skipped = "/* a\n#endif */ s = \"a\\\n#endif\"; // c \\\n#endif\nx \\\n#endif\nR\"(\n#endif)\"\n  #else\n";
+  const char* pSkipped = findSkippedDirective(skipped.data(), skipped.data() + skipped.size());
+  same = same && std::string(pSkipped) == "#else\n";
+  std::cout << "\n  skipped text's directive isn't in a comment, literal, or splice: " << same;
+
+  std::string utf8 = "\xC3\xA9t\xC3\xA9 \xE2\x82";
+  const char* pAfter = skipUtf8(utf8.data(), utf8.data() + utf8.size(), complete);
+  same = same && pAfter == utf8.data() + 2 && complete;
+  pAfter = skipUtf8(utf8.data() + 6, utf8.data() + utf8.size(), complete);
+  same = same && pAfter == utf8.data() + utf8.size() && !complete;
+  std::cout << "\n  complete and truncated UTF-8 sequences found: " << same;
+  std::cout << "\n\n";
+  return same ? 0 : 1;
+}
+#endif
@@ -0,0 +1,155 @@
+#ifndef CHARSCAN_H
+#define CHARSCAN_H
+///////////////////////////////////////////////////////////////////////////////
+// CharScan.h - vectorized scanners for runs of source characters           //
+// ver 1.6                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides the run scanners Toker uses for buffer input.
+* Each one returns a pointer to the first char in [pBegin, pEnd) that
+* ends the run, or pEnd if the run reaches the end of the buffer:
+* - skipBlanks     whitespace other than newline, as std::isspace in
+*                  the "C" locale
+* - skipIdent      letters, digits, and underscore
+* - findNewline    the '\n' that ends a C++ comment
+* - findCommentEnd the '*' of the first star, slash pair, or a '*' that
+*                  is the last char of the buffer
+* - findLiteralEnd the quote that closes a literal, or the line end
+*                  that stops it, the first not escaped by an odd
+*                  backslash run
+* - findDirective  the '#' of the next preprocessor directive line
+* - findSkippedDirective  the same, passing over comments, literals,
+*                  and line splices, for skipping inactive regions
+* - skipNumber     a C++ preprocessing number: digits, letters, '.',
+*                  digit separators, and exponent signs
+* - findRawLiteralEnd  one past the )delim" that closes a raw string
+* - findDirectiveEnd   end of the preprocessor directive led by '#'
+* - skipUtf8       the valid part of one UTF-8 sequence
+*
+* DirectiveScan follows a directive one char at a time, through line
+* splices, literals, and C comments, for input that isn't buffered.
+* findDirectiveEnd() runs it over a buffer, so both agree on where a
+* directive ends: before the line end or a trailing C++ comment.
+*
+* It also provides the locale independent char tests the lexers use
+* in place of std::isspace(), std::isalnum(), and std::ispunct().
+*
+* There are SSE2 and AVX2 versions, which test 16 or 32 chars per step,
+* and a scalar fallback.  The best version the cpu supports is chosen on
+* first use.  setScanLevel() selects a lower level for testing and
+* benchmarking.  All levels return the same results.
+*
+* Public Interface:
+* -----------------
+* const char* pEndOfWord = skipIdent(pChar, pEnd);
+* setScanLevel(ScanLevel::scalar);
+* std::cout << scanLevelName(scanLevel());
+*
+* Build Process:
+* --------------
+* Required Files: CharScan.h, CharScan.cpp
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.6 : 18 Oct 2026
+* - added findSkippedDirective(), so a '#' in a comment doesn't end an
+*   inactive region
+* ver 1.5 : 18 Oct 2026
+* - added DirectiveScan and findDirectiveEnd()
+* ver 1.4 : 18 Oct 2026
+* - added skipNumber(), findRawLiteralEnd(), isDigitChar(),
+*   isRawDelimiterChar(), and isRawPrefix()
+* ver 1.3 : 18 Oct 2026
+* - findQuote() is now findLiteralEnd(), which also stops at a line
+*   end, so an unclosed quote can't run on to the end of the file
+* ver 1.2 : 18 Oct 2026
+* - added skipUtf8() and the char tests isBlankChar(), isIdentChar(),
+*   isPunctChar(), and isUtf8Lead(), moved here from Tokenizer.cpp so
+*   StaticToker can share them
+* ver 1.1 : 18 Oct 2026
+* - added findDirective(), for skipping inactive preprocessor regions
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+#include <cstddef>
+
+namespace Scanner
+{
+  enum class ScanLevel { scalar, sse2, avx2 };
+
+  const char* skipBlanks(const char* pBegin, const char* pEnd);
+  const char* skipIdent(const char* pBegin, const char* pEnd);
+  const char* findNewline(const char* pBegin, const char* pEnd);
+  const char* findCommentEnd(const char* pBegin, const char* pEnd);
+  const char* findLiteralEnd(const char* pBegin, const char* pEnd, char quote);
+  const char* findDirective(const char* pBegin, const char* pEnd);
+  const char* findSkippedDirective(const char* pBegin, const char* pEnd);
+  const char* skipUtf8(const char* pLead, const char* pEnd, bool& complete);
+  const char* skipNumber(const char* pBegin, const char* pEnd);
+  const char* findRawLiteralEnd(const char* pQuote, const char* pEnd, bool& complete);
+  const char* findDirectiveEnd(const char* pHash, const char* pEnd, const char*& pStop);
+
+  /////////////////////////////////////////////////////////////////////
+  // DirectiveScan: is the next char still part of the directive?
+
+  struct DirectiveScan
+  {
+    bool takes(int ch, int chNext);  // chNext matters only when ch is '/'
+    int _quote = 0;
+    bool _escaped = false;
+    bool _splice = false;    // last char was '\\', or '\r' after one
+    bool _inComment = false;
+    bool _opening = false;   // next char is the '*' of "/*"
+    bool _star = false;
+  };
+
+  // ch is 0..255 or EOF, with "C" locale semantics
+  inline bool isBlankChar(int ch)
+  {
+    return ch == ' ' || ch == '\t' || ch == '\v' || ch == '\f' || ch == '\r';
+  }
+  inline bool isIdentChar(int ch)
+  {
+    return (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_';
+  }
+  inline bool isPunctChar(int ch)
+  {
+    return ch > ' ' && ch < 127 && (ch == '_' || !isIdentChar(ch));
+  }
+  inline bool isUtf8Lead(int ch)
+  {
+    return ch >= 0xC2 && ch <= 0xF4;
+  }
+  inline bool isDigitChar(int ch)
+  {
+    return ch >= '0' && ch <= '9';
+  }
+  inline bool isRawDelimiterChar(int ch)
+  {
+    return ch > ' ' && ch < 127 && ch != '(' && ch != ')' && ch != '\\';
+  }
+  // R, LR, uR, UR, or u8R, the identifiers that start a raw string
+  inline bool isRawPrefix(const char* pTok, size_t size)
+  {
+    if (size == 0 || pTok[size - 1] != 'R')
+      return false;
+    return size == 1 || (size == 2 && (pTok[0] == 'L' || pTok[0] == 'u' || pTok[0] == 'U'))
+      || (size == 3 && pTok[0] == 'u' && pTok[1] == '8');
+  }
+  const size_t maxRawDelimiter = 16;
+
+  ScanLevel bestScanLevel();
+  ScanLevel scanLevel();
+  ScanLevel setScanLevel(ScanLevel level);
+  const char* scanLevelName(ScanLevel level);
+}
+#endif
@@ -0,0 +1,647 @@
+///////////////////////////////////////////////////////////////////////////////
+// Conditionals.cpp - evaluates preprocessor conditions for Toker            //
+// ver 1.2                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Expressions are evaluated by recursive descent on a value that is
+* either a known integer or unknown.  Unknown propagates, except where
+* the result doesn't depend on it:  0 && x, 1 || x, and the untaken arm
+* of ?:.  Anything the evaluator doesn't understand, e.g., a function
+* like macro, is unknown rather than an error.
+*
+* Build Process:
+* --------------
+* Required Files: Conditionals.h, Conditionals.cpp, CharScan.h, CharScan.cpp
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.2 : 18 Oct 2026
+* - added ConditionStack::save() and restore()
+* ver 1.1 : 18 Oct 2026
+* - added readDirectiveToken()
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include "Conditionals.h"
+#include "CharScan.h"
+
+using namespace Scanner;
+
+namespace
+{
+  const size_t maxExpansionDepth = 16;
+
+  inline bool isIdentChar(char ch)
+  {
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_';
+  }
+
+  inline bool isBlankChar(char ch)
+  {
+    return ch == ' ' || ch == '\t' || ch == '\v' || ch == '\f' || ch == '\r';
+  }
+
+  struct Value
+  {
+    long long v;
+    bool known;
+  };
+
+  const Value unknownValue = { 0, false };
+
+  inline Value known(long long v) { return Value{ v, true }; }
+
+  /////////////////////////////////////////////////////////////////
+  // Evaluator: recursive descent over one expression's text
+
+  class Evaluator
+  {
+  public:
+    Evaluator(const Conditionals& conds, const char* pBegin, const char* pEnd, size_t depth)
+      : _conds(conds), _pChar(pBegin), _pEnd(pEnd), _depth(depth) {}
+    Value evaluate()
+    {
+      Value value = conditional();
+      skipSpace();
+      if (_failed || _pChar != _pEnd)
+        return unknownValue;
+      return value;
+    }
+  private:
+    void skipSpace();
+    bool accept(const char* op);
+    bool peekIs(const char* op);
+    std::string identifier();
+    Value conditional();
+    Value binary(int minPrecedence);
+    Value unary();
+    Value primary();
+    Value number();
+    Value macro(const std::string& name);
+    Value apply(const std::string& op, Value left, Value right);
+    int precedence(std::string& op);
+
+    const Conditionals& _conds;
+    const char* _pChar;
+    const char* _pEnd;
+    size_t _depth;
+    bool _failed = false;
+  };
+
+  //----< skip blanks, line continuations, and comments >------------
+
+  void Evaluator::skipSpace()
+  {
+    while (_pChar < _pEnd)
+    {
+      if (isBlankChar(*_pChar) || *_pChar == '\n')
+        ++_pChar;
+      else if (*_pChar == '\\' && _pChar + 1 < _pEnd && (_pChar[1] == '\n' || _pChar[1] == '\r'))
+        ++_pChar;
+      else if (*_pChar == '/' && _pChar + 1 < _pEnd && _pChar[1] == '/')
+        _pChar = _pEnd;
+      else if (*_pChar == '/' && _pChar + 1 < _pEnd && _pChar[1] == '*')
+      {
+        const char* pClose = static_cast<const char*>(std::memchr(_pChar + 2, '/', _pEnd - _pChar - 2));
+        while (pClose != nullptr && pClose[-1] != '*')
+          pClose = static_cast<const char*>(std::memchr(pClose + 1, '/', _pEnd - pClose - 1));
+        _pChar = pClose == nullptr ? _pEnd : pClose + 1;
+      }
+      else
+        break;
+    }
+  }
+  //----< consume op if it comes next >------------------------------
+
+  bool Evaluator::accept(const char* op)
+  {
+    if (!peekIs(op))
+      return false;
+    _pChar += std::strlen(op);
+    return true;
+  }
+
+  bool Evaluator::peekIs(const char* op)
+  {
+    skipSpace();
+    size_t size = std::strlen(op);
+    return static_cast<size_t>(_pEnd - _pChar) >= size && std::memcmp(_pChar, op, size) == 0;
+  }
+
+  std::string Evaluator::identifier()
+  {
+    skipSpace();
+    const char* pStart = _pChar;
+    if (_pChar < _pEnd && !(*_pChar >= '0' && *_pChar <= '9'))
+      while (_pChar < _pEnd && isIdentChar(*_pChar))
+        ++_pChar;
+    return std::string(pStart, _pChar);
+  }
+  //----< cond ? a : b >---------------------------------------------
+
+  Value Evaluator::conditional()
+  {
+    Value cond = binary(1);
+    if (!accept("?"))
+      return cond;
+    Value ifTrue = conditional();
+    if (!accept(":"))
+    {
+      _failed = true;
+      return unknownValue;
+    }
+    Value ifFalse = conditional();
+    if (!cond.known)
+    {
+      bool same = ifTrue.known && ifFalse.known && ifTrue.v == ifFalse.v;
+      return same ? ifTrue : unknownValue;
+    }
+    return cond.v != 0 ? ifTrue : ifFalse;
+  }
+  //----< next binary operator and its precedence, 0 if none >-------
+
+  int Evaluator::precedence(std::string& op)
+  {
+    static const struct { const char* op; int precedence; } ops[] = {
+      { "||", 1 }, { "&&", 2 }, { "==", 6 }, { "!=", 6 }, { "<=", 7 }, { ">=", 7 },
+      { "<<", 8 }, { ">>", 8 }, { "|", 3 }, { "^", 4 }, { "&", 5 }, { "<", 7 },
+      { ">", 7 }, { "+", 9 }, { "-", 9 }, { "*", 10 }, { "/", 10 }, { "%", 10 }
+    };
+    for (auto& entry : ops)
+    {
+      if (peekIs(entry.op))
+      {
+        op = entry.op;
+        return entry.precedence;
+      }
+    }
+    return 0;
+  }
+  //----< left associative binary operators, by precedence >---------
+
+  Value Evaluator::binary(int minPrecedence)
+  {
+    Value left = unary();
+    std::string op;
+    int prec;
+    while (!_failed && (prec = precedence(op)) >= minPrecedence && prec > 0)
+    {
+      _pChar += op.size();
+      Value right = binary(prec + 1);
+      left = apply(op, left, right);
+    }
+    return left;
+  }
+  //----< value of left op right, unknown unless determined >--------
+
+  Value Evaluator::apply(const std::string& op, Value left, Value right)
+  {
+    if (op == "&&")
+    {
+      if ((left.known && left.v == 0) || (right.known && right.v == 0))
+        return known(0);
+      return left.known && right.known ? known(1) : unknownValue;
+    }
+    if (op == "||")
+    {
+      if ((left.known && left.v != 0) || (right.known && right.v != 0))
+        return known(1);
+      return left.known && right.known ? known(0) : unknownValue;
+    }
+    if (!left.known || !right.known)
+      return unknownValue;
+    long long l = left.v, r = right.v;
+    switch (op[0])
+    {
+    case '=': return known(l == r);
+    case '!': return known(l != r);
+    case '<':
+      if (op == "<<") return known(r >= 0 && r < 64 ? l << r : 0);
+      return known(op == "<=" ? l <= r : l < r);
+    case '>':
+      if (op == ">>") return known(r >= 0 && r < 64 ? l >> r : 0);
+      return known(op == ">=" ? l >= r : l > r);
+    case '|': return known(l | r);
+    case '^': return known(l ^ r);
+    case '&': return known(l & r);
+    case '+': return known(l + r);
+    case '-': return known(l - r);
+    case '*': return known(l * r);
+    case '/': return r == 0 ? unknownValue : known(l / r);
+    case '%': return r == 0 ? unknownValue : known(l % r);
+    }
+    return unknownValue;
+  }
+  //----< ! ~ - + prefixes >-----------------------------------------
+
+  Value Evaluator::unary()
+  {
+    if (accept("!"))
+    {
+      Value value = unary();
+      return value.known ? known(value.v == 0) : value;
+    }
+    if (accept("~"))
+    {
+      Value value = unary();
+      return value.known ? known(~value.v) : value;
+    }
+    if (accept("-"))
+    {
+      Value value = unary();
+      return value.known ? known(-value.v) : value;
+    }
+    if (accept("+"))
+      return unary();
+    return primary();
+  }
+  //----< (expr), number, char literal, defined, or macro >----------
+
+  Value Evaluator::primary()
+  {
+    skipSpace();
+    if (_pChar == _pEnd)
+    {
+      _failed = true;
+      return unknownValue;
+    }
+    if (accept("("))
+    {
+      Value value = conditional();
+      if (!accept(")"))
+        _failed = true;
+      return value;
+    }
+    if (*_pChar >= '0' && *_pChar <= '9')
+      return number();
+    if (*_pChar == '\'')
+    {
+      if (_pEnd - _pChar >= 3 && _pChar[1] != '\\' && _pChar[2] == '\'')
+      {
+        long long v = static_cast<unsigned char>(_pChar[1]);
+        _pChar += 3;
+        return known(v);
+      }
+      _failed = true;
+      return unknownValue;
+    }
+    std::string name = identifier();
+    if (name.empty())
+    {
+      _failed = true;
+      return unknownValue;
+    }
+    if (name == "defined")
+    {
+      bool paren = accept("(");
+      std::string macroName = identifier();
+      if (macroName.empty() || (paren && !accept(")")))
+      {
+        _failed = true;
+        return unknownValue;
+      }
+      Truth truth = _conds.isDefined(macroName);
+      return truth == Truth::unknown ? unknownValue : known(truth == Truth::yes);
+    }
+    if (peekIs("("))    // function like macro, or __has_include
+    {
+      int nesting = 0;
+      do
+      {
+        if (*_pChar == '(')
+          ++nesting;
+        else if (*_pChar == ')')
+          --nesting;
+        ++_pChar;
+      } while (nesting > 0 && _pChar < _pEnd);
+      if (nesting > 0)
+        _failed = true;
+      return unknownValue;
+    }
+    return macro(name);
+  }
+  //----< integer literal, with any u and l suffixes >---------------
+
+  Value Evaluator::number()
+  {
+    const char* pStart = _pChar;
+    while (_pChar < _pEnd && (isIdentChar(*_pChar) || *_pChar == '\''))
+      ++_pChar;
+    std::string digits;
+    for (const char* pDigit = pStart; pDigit < _pChar; ++pDigit)
+      if (*pDigit != '\'')
+        digits += *pDigit;
+    while (!digits.empty() && std::strchr("uUlL", digits.back()) != nullptr)
+      digits.pop_back();
+    char* pParsed = nullptr;
+    unsigned long long v = std::strtoull(digits.c_str(), &pParsed, 0);
+    if (digits.empty() || *pParsed != '\0')
+    {
+      _failed = true;
+      return unknownValue;
+    }
+    return known(static_cast<long long>(v));
+  }
+  //----< value of an identifier, expanding known macros >-----------
+
+  Value Evaluator::macro(const std::string& name)
+  {
+    if (name == "true")
+      return known(1);
+    if (name == "false")
+      return known(0);
+    std::string text;
+    if (_conds.macroValue(name, text))
+    {
+      if (_depth >= maxExpansionDepth || text.empty())
+        return unknownValue;
+      return Evaluator(_conds, text.data(), text.data() + text.size(), _depth + 1).evaluate();
+    }
+    return _conds.isDefined(name) == Truth::no ? known(0) : unknownValue;
+  }
+}
+
+//----< add a macro known to be defined >----------------------------
+
+void Conditionals::define(const std::string& name, const std::string& value)
+{
+  _undefined.erase(name);
+  _defined[name] = value;
+}
+//----< add a macro known not to be defined >------------------------
+
+void Conditionals::undefine(const std::string& name)
+{
+  _defined.erase(name);
+  _undefined.insert(name);
+}
+//----< build from "NAME, NAME=value, !NAME" >-----------------------
+
+Conditionals::Ptr Conditionals::compile(const std::string& commaSeparatedMacros)
+{
+  std::shared_ptr<Conditionals> pConds(new Conditionals);
+  size_t pos = 0;
+  while (pos <= commaSeparatedMacros.size())
+  {
+    size_t comma = commaSeparatedMacros.find(',', pos);
+    if (comma == std::string::npos)
+      comma = commaSeparatedMacros.size();
+    std::string item = commaSeparatedMacros.substr(pos, comma - pos);
+    pos = comma + 1;
+    size_t first = item.find_first_not_of(" \t");
+    if (first == std::string::npos)
+      continue;
+    size_t last = item.find_last_not_of(" \t");
+    item = item.substr(first, last - first + 1);
+    if (item[0] == '!')
+    {
+      pConds->undefine(item.substr(1));
+      continue;
+    }
+    size_t equals = item.find('=');
+    if (equals == std::string::npos)
+      pConds->define(item);
+    else
+      pConds->define(item.substr(0, equals), item.substr(equals + 1));
+  }
+  return pConds;
+}
+//----< is name defined, not defined, or unknown? >------------------
+
+Truth Conditionals::isDefined(const std::string& name) const
+{
+  if (_defined.find(name) != _defined.end())
+    return Truth::yes;
+  if (_undefined.find(name) != _undefined.end())
+    return Truth::no;
+  return Truth::unknown;
+}
+//----< value text of a defined macro >------------------------------
+
+bool Conditionals::macroValue(const std::string& name, std::string& value) const
+{
+  auto iter = _defined.find(name);
+  if (iter == _defined.end())
+    return false;
+  value = iter->second;
+  return true;
+}
+//----< truth of an #if or #elif expression >------------------------
+
+Truth Conditionals::evaluate(const char* pBegin, const char* pEnd) const
+{
+  Value value = Evaluator(*this, pBegin, pEnd, 0).evaluate();
+  if (!value.known)
+    return Truth::unknown;
+  return value.v != 0 ? Truth::yes : Truth::no;
+}
+
+namespace
+{
+  //----< kind of directive named [pName, pNameEnd) >-----------------
+
+  DirectiveKind directiveKind(const char* pName, const char* pNameEnd)
+  {
+    struct Entry
+    {
+      const char* name;
+      DirectiveKind kind;
+    };
+    static const Entry entries[] = {
+      { "if", DirectiveKind::ifCond }, { "ifdef", DirectiveKind::ifdefCond },
+      { "ifndef", DirectiveKind::ifndefCond }, { "elif", DirectiveKind::elifCond },
+      { "else", DirectiveKind::elseCond }, { "endif", DirectiveKind::endifCond },
+      { "include", DirectiveKind::include }, { "define", DirectiveKind::define },
+      { "undef", DirectiveKind::undef }, { "pragma", DirectiveKind::pragma },
+      { "error", DirectiveKind::error }, { "line", DirectiveKind::line }
+    };
+    size_t size = pNameEnd - pName;
+    for (const Entry& entry : entries)
+    {
+      if (std::strlen(entry.name) == size && std::memcmp(entry.name, pName, size) == 0)
+        return entry.kind;
+    }
+    return DirectiveKind::other;
+  }
+  //----< first char after the directive name that follows pHash >----
+
+  const char* skipDirectiveName(const char* pHash, const char* pEnd, const char*& pName)
+  {
+    pName = pHash + 1;
+    while (pName < pEnd && isBlankChar(*pName))
+      ++pName;
+    const char* pNameEnd = pName;
+    while (pNameEnd < pEnd && isIdentChar(*pNameEnd))
+      ++pNameEnd;
+    return pNameEnd;
+  }
+}
+
+//----< kind and extent of the directive starting at pHash >---------
+/*
+ * The line ends at the first newline not escaped by a backslash.
+ */
+Directive Scanner::readDirective(const char* pHash, const char* pEnd)
+{
+  Directive directive;
+  const char* pLineEnd = pHash;
+  while ((pLineEnd = findNewline(pLineEnd, pEnd)) < pEnd)
+  {
+    const char* pLast = pLineEnd - 1;
+    if (pLast > pHash && *pLast == '\r')
+      --pLast;
+    if (*pLast != '\\')
+      break;
+    ++pLineEnd;
+  }
+  directive.pNextLine = pLineEnd < pEnd ? pLineEnd + 1 : pEnd;
+
+  const char* pName;
+  const char* pNameEnd = skipDirectiveName(pHash, pLineEnd, pName);
+  directive.kind = directiveKind(pName, pNameEnd);
+  directive.pExpression = pNameEnd;
+  directive.pExpressionEnd = pLineEnd;
+  return directive;
+}
+//----< kind and argument of a directive token [pBegin, pEnd) >------
+/*
+ * The token is the whole directive, e.g., "#include <vector>", as
+ * Toker returns it with returnDirectives(), so it may hold escaped
+ * newlines and comments.  The argument, pExpression to
+ * pExpressionEnd, is the text after the name, without the blanks
+ * around it, e.g., "<vector>".
+ */
+Directive Scanner::readDirectiveToken(const char* pBegin, const char* pEnd)
+{
+  Directive directive;
+  directive.pNextLine = pEnd;
+  if (pBegin == pEnd)
+    return directive;
+  const char* pName;
+  const char* pArgument = skipDirectiveName(pBegin, pEnd, pName);
+  directive.kind = directiveKind(pName, pArgument);
+  while (pArgument < pEnd && isBlankChar(*pArgument))
+    ++pArgument;
+  const char* pArgumentEnd = pEnd;
+  while (pArgumentEnd > pArgument && isBlankChar(pArgumentEnd[-1]))
+    --pArgumentEnd;
+  directive.pExpression = pArgument;
+  directive.pExpressionEnd = pArgumentEnd;
+  return directive;
+}
+
+//----< update groups for directive, true if the lines after it are active >
+/*
+ * Called for directives in active regions, and, while skipping, for
+ * the #elif, #else, and #endif of the group being skipped.
+ */
+bool ConditionStack::apply(const Directive& directive, const Conditionals& conditionals)
+{
+  Truth truth = Truth::unknown;
+  switch (directive.kind)
+  {
+  case DirectiveKind::ifCond:
+  case DirectiveKind::elifCond:
+    truth = conditionals.evaluate(directive.pExpression, directive.pExpressionEnd);
+    break;
+  case DirectiveKind::ifdefCond:
+  case DirectiveKind::ifndefCond:
+  {
+    const char* pName = directive.pExpression;
+    while (pName < directive.pExpressionEnd && isBlankChar(*pName))
+      ++pName;
+    const char* pNameEnd = pName;
+    while (pNameEnd < directive.pExpressionEnd && isIdentChar(*pNameEnd))
+      ++pNameEnd;
+    truth = pName == pNameEnd ? Truth::unknown : conditionals.isDefined(std::string(pName, pNameEnd));
+    if (directive.kind == DirectiveKind::ifndefCond && truth != Truth::unknown)
+      truth = truth == Truth::yes ? Truth::no : Truth::yes;
+    break;
+  }
+  default:
+    break;
+  }
+
+  if (directive.opensGroup())
+  {
+    _groups.push_back(Group{ truth == Truth::yes, truth == Truth::unknown });
+    return truth != Truth::no;
+  }
+  if (directive.kind == DirectiveKind::endifCond)
+  {
+    if (!_groups.empty())
+      _groups.pop_back();
+    return true;
+  }
+  if (_groups.empty() || !directive.isConditional())
+    return true;
+
+  Group& group = _groups.back();
+  if (group.unknown)
+    return true;
+  if (group.taken)
+    return false;
+  if (directive.kind == DirectiveKind::elseCond)
+    truth = Truth::yes;
+  group.taken = truth == Truth::yes;
+  group.unknown = truth == Truth::unknown;
+  return truth != Truth::no;
+}
+//----< copy of the open groups, one byte each, outermost first >----
+
+void ConditionStack::save(std::vector<unsigned char>& groups) const
+{
+  groups.clear();
+  for (const Group& group : _groups)
+    groups.push_back(static_cast<unsigned char>((group.taken ? 1 : 0) | (group.unknown ? 2 : 0)));
+}
+//----< reopen the groups save() copied >----------------------------
+
+void ConditionStack::restore(const std::vector<unsigned char>& groups)
+{
+  _groups.clear();
+  for (unsigned char group : groups)
+    _groups.push_back(Group{ (group & 1) != 0, (group & 2) != 0 });
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_CONDITIONALS
+
+#include <iostream>
+#include "../Utilities/Utilities.h"
+
+int main()
+{
+  Utilities::StringHelper::Title("Testing Conditionals");
+
+  Conditionals::Ptr pConds = Conditionals::compile("_WIN32, DEBUG=0, LEVEL=DEBUG+2, !__linux__");
+  const char* names[] = { "no", "yes", "unknown" };
+  for (const char* expression : {
+    "0", "1", "defined(_WIN32)", "defined __linux__", "DEBUG", "LEVEL > 1",
+    "defined(_WIN32) && !defined(__linux__)", "UNKNOWN_MACRO", "0 && UNKNOWN_MACRO",
+    "UNKNOWN_MACRO || 1", "(LEVEL << 2) == 8 ? 1 : 0", "__has_include(<x.h>)", "1 +" })
+  {
+    std::cout << "\n  #if " << expression << "  -->  " << names[static_cast<int>(pConds->evaluate(expression))];
+  }
+
+  std::string record = "#  define  MAX(a, b) \\\n  ((a) > (b) ? (a) : (b))  ";
+  Directive directive = readDirectiveToken(record.data(), record.data() + record.size());
+  std::cout << "\n\n  define record: " << std::boolalpha << (directive.kind == DirectiveKind::define)
+    << ", argument: " << std::string(directive.pExpression, directive.pExpressionEnd);
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,135 @@
+#ifndef CONDITIONALS_H
+#define CONDITIONALS_H
+///////////////////////////////////////////////////////////////////////////////
+// Conditionals.h - evaluates preprocessor conditions for Toker              //
+// ver 1.2                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package lets Toker skip the inactive regions of #if, #ifdef,
+* #ifndef, #elif, #else, and #endif groups without tokenizing them.
+*
+* A Conditionals instance holds the macros the caller knows about:
+* - defined macros, with a value, "1" if none is given
+* - undefined macros, known not to be defined
+* Every other macro is unknown.  evaluate() computes the value of an #if
+* or #elif expression, with the usual C operators, defined(X), and true
+* and false, and returns Truth::unknown if the answer depends on an
+* unknown macro, so Toker keeps tokenizing every branch of that group,
+* as it always did.  Only groups whose conditions are known are skipped.
+*
+* Like SpecialTokens, a Conditionals is immutable once compiled, and can
+* be shared by many Tokers through a Conditionals::Ptr.
+*
+* ConditionStack tracks the nesting of groups, and readDirective() finds
+* the kind and expression of a directive line.  readDirectiveToken()
+* finds the kind and argument of a directive Toker returned whole.
+*
+* Public Interface:
+* -----------------
+* Conditionals::Ptr pConds = Conditionals::compile("_WIN32, DEBUG=0, !__linux__");
+* toker.setConditionals(pConds);
+* toker.attach(file);                        // MappedFile or buffer input
+* if (pConds->evaluate("DEBUG > 1") == Truth::no) ...
+* Directive d = readDirectiveToken(record.text.begin(), record.text.end());
+* if (d.kind == DirectiveKind::include) ...
+*
+* Build Process:
+* --------------
+* Required Files: Conditionals.h, Conditionals.cpp, CharScan.h, CharScan.cpp
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.2 : 18 Oct 2026
+* - added ConditionStack::save() and restore(), for Toker's checkpoints
+* ver 1.1 : 18 Oct 2026
+* - added readDirectiveToken(), and directive kinds for #include,
+*   #define, #undef, #pragma, #error, and #line
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Scanner
+{
+  enum class Truth { no, yes, unknown };
+
+  class Conditionals
+  {
+  public:
+    using Ptr = std::shared_ptr<const Conditionals>;
+    void define(const std::string& name, const std::string& value = "1");
+    void undefine(const std::string& name);
+    static Ptr compile(const std::string& commaSeparatedMacros);
+    Truth isDefined(const std::string& name) const;
+    Truth evaluate(const char* pBegin, const char* pEnd) const;
+    Truth evaluate(const std::string& expression) const
+    {
+      return evaluate(expression.data(), expression.data() + expression.size());
+    }
+    bool macroValue(const std::string& name, std::string& value) const;
+  private:
+    std::unordered_map<std::string, std::string> _defined;
+    std::unordered_set<std::string> _undefined;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // Directive: one preprocessor line, from its '#' through its newline
+
+  enum class DirectiveKind {
+    other, ifCond, ifdefCond, ifndefCond, elifCond, elseCond, endifCond,
+    include, define, undef, pragma, error, line
+  };
+
+  struct Directive
+  {
+    DirectiveKind kind = DirectiveKind::other;
+    const char* pExpression = nullptr;  // text after the directive name
+    const char* pExpressionEnd = nullptr;
+    const char* pNextLine = nullptr;    // first char after the line's newline
+    bool opensGroup() const
+    {
+      return kind == DirectiveKind::ifCond || kind == DirectiveKind::ifdefCond || kind == DirectiveKind::ifndefCond;
+    }
+    bool isConditional() const
+    {
+      return kind >= DirectiveKind::ifCond && kind <= DirectiveKind::endifCond;
+    }
+  };
+
+  Directive readDirective(const char* pHash, const char* pEnd);
+  Directive readDirectiveToken(const char* pBegin, const char* pEnd);
+
+  /////////////////////////////////////////////////////////////////////
+  // ConditionStack: the open #if groups and which branch is taken
+
+  class ConditionStack
+  {
+  public:
+    void clear() { _groups.clear(); }
+    bool apply(const Directive& directive, const Conditionals& conditionals);
+    size_t depth() const { return _groups.size(); }
+    void save(std::vector<unsigned char>& groups) const;
+    void restore(const std::vector<unsigned char>& groups);
+  private:
+    struct Group
+    {
+      bool taken;     // a branch of the group has been active
+      bool unknown;   // a condition was unknown, so every branch is active
+    };
+    std::vector<Group> _groups;
+  };
+}
+#endif
@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////
+// LineIndex.cpp - maps input offsets to line numbers                        //
+// ver 1.0                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* The line of an offset is one more than the number of newlines before
+* it, found with std::lower_bound.
+*
+* Build Process:
+* --------------
+* Required Files: LineIndex.h, LineIndex.cpp, CharScan.h, CharScan.cpp
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 18 Oct 2026
+* - added setCapacity()
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include "LineIndex.h"
+#include "CharScan.h"
+
+using namespace Scanner;
+
+//----< keep at most maxNewlines newlines, 0 for no limit >----------
+
+void LineIndex::setCapacity(size_t maxNewlines)
+{
+  _capacity = maxNewlines;
+  if (_capacity > 0)
+  {
+    _capacity = std::max<size_t>(_capacity, 2);
+    while (_newlines.size() > _capacity)
+      dropOldest();
+    _newlines.reserve(_capacity);
+  }
+}
+//----< forget the older half of the newlines, keep their count >----
+
+void LineIndex::dropOldest()
+{
+  size_t half = _newlines.size() / 2;
+  _lastDropped = _newlines[half - 1];
+  _newlines.erase(_newlines.begin(), _newlines.begin() + half);
+  _dropped += half;
+}
+//----< index every newline in [pBegin, pEnd) >----------------------
+
+void LineIndex::build(const char* pBegin, const char* pEnd)
+{
+  clear();
+  const char* pChar = pBegin;
+  while ((pChar = findNewline(pChar, pEnd)) < pEnd)
+  {
+    addNewline(pChar - pBegin);
+    ++pChar;
+  }
+}
+//----< line of the char at offset, counting from 1 >----------------
+/*
+ * Offsets before the newlines still held report the oldest line still
+ * known.
+ */
+size_t LineIndex::lineOf(size_t offset) const
+{
+  return 1 + _dropped + (std::lower_bound(_newlines.begin(), _newlines.end(), offset) - _newlines.begin());
+}
+//----< offset of the first char of line >---------------------------
+/*
+ * Lines that started before the newlines still held report the start
+ * of the oldest line still known.
+ */
+size_t LineIndex::lineStart(size_t line) const
+{
+  if (line <= 1 + _dropped || _newlines.empty())
+    return _dropped > 0 ? _lastDropped + 1 : 0;
+  size_t index = line - 2 - _dropped;
+  if (index >= _newlines.size())
+    return _newlines.back() + 1;
+  return _newlines[index] + 1;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_LINEINDEX
+
+#include <iostream>
+#include <string>
+#include "../Utilities/Utilities.h"
+
+int main()
+{
+  Utilities::StringHelper::Title("Testing LineIndex");
+
+  std::string text = "first line\nsecond line\n\nfourth line";
+  LineIndex lines;
+  lines.build(text.data(), text.data() + text.size());
+  std::cout << "\n  " << lines.newlines() << " newlines";
+  for (size_t offset : { 0, 10, 11, 23, 24, 34 })
+  {
+    std::cout << "\n  offset " << offset << " is on line " << lines.lineOf(offset)
+      << ", which starts at offset " << lines.lineStart(lines.lineOf(offset));
+  }
+
+  LineIndex recent;
+  recent.setCapacity(4);
+  recent.build(text.data(), text.data() + text.size());
+  recent.addNewline(40);
+  recent.addNewline(50);
+  recent.addNewline(60);
+  std::cout << "\n\n  keeping 4 of " << recent.newlines() << " newlines, offset 55 is on line "
+    << recent.lineOf(55);
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,77 @@
+#ifndef LINEINDEX_H
+#define LINEINDEX_H
+///////////////////////////////////////////////////////////////////////////////
+// LineIndex.h - maps input offsets to line numbers                          //
+// ver 1.0                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a LineIndex class that holds the offset of every
+* newline in an input, in increasing order.  The line of any offset is
+* then found with a binary search, so a tokenizer only has to record
+* each token's offset, and lines are computed when someone asks.
+*
+* build() indexes a whole buffer in one pass with the vectorized
+* findNewline() scanner.  addNewline() grows the index one newline at
+* a time, for input that arrives as a stream.
+*
+* setCapacity(n) bounds the index to the most recent n newlines.  When
+* it fills, the older half is dropped and only counted, so lineOf() is
+* still exact for offsets after the dropped newlines.
+*
+* Lines are numbered from 1.  A newline belongs to the line it ends.
+*
+* Public Interface:
+* -----------------
+* LineIndex lines;
+* lines.build(pBegin, pEnd);
+* size_t line = lines.lineOf(tokenOffset);
+* size_t start = lines.lineStart(line);
+*
+* Build Process:
+* --------------
+* Required Files: LineIndex.h, LineIndex.cpp, CharScan.h, CharScan.cpp
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 18 Oct 2026
+* - added setCapacity(), for tokenizers with bounded memory
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+#include <vector>
+
+namespace Scanner
+{
+  class LineIndex
+  {
+  public:
+    void clear() { _newlines.clear(); _dropped = 0; _lastDropped = 0; }
+    void setCapacity(size_t maxNewlines);
+    void build(const char* pBegin, const char* pEnd);
+    void addNewline(size_t offset)
+    {
+      if (_capacity > 0 && _newlines.size() >= _capacity)
+        dropOldest();
+      _newlines.push_back(offset);
+    }
+    size_t lineOf(size_t offset) const;
+    size_t lineStart(size_t line) const;
+    size_t newlines() const { return _dropped + _newlines.size(); }
+  private:
+    void dropOldest();
+    std::vector<size_t> _newlines;   // offset of each '\n', increasing
+    size_t _capacity = 0;            // 0 for unbounded
+    size_t _dropped = 0;             // newlines before _newlines[0]
+    size_t _lastDropped = 0;         // offset of the last of them
+  };
+}
+#endif
@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+// MappedFile.cpp - read-only memory-mapped view of a source file           //
+// ver 1.0                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a MappedFile class that maps an entire file into
+* the address space of the process, read only.  Toker can attach to the
+* mapped bytes and scan them with pointer arithmetic instead of pulling
+* every character through std::istream::get().
+*
+* Empty files can't be mapped on either platform, so they are reported
+* as open with a zero length range.
+*
+* Build Process:
+* --------------
+* Required Files: MappedFile.h, MappedFile.cpp
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Scanner;
+
+namespace
+{
+  const char emptyFile[] = "";
+}
+
+//----< construct closed mapping >-----------------------------------
+
+MappedFile::MappedFile() : _pData(emptyFile), _size(0), _isOpen(false)
+#ifdef _WIN32
+  , _hFile(INVALID_HANDLE_VALUE), _hMapping(nullptr)
+#endif
+{}
+
+//----< construct and map fileSpec >---------------------------------
+
+MappedFile::MappedFile(const std::string& fileSpec) : MappedFile()
+{
+  open(fileSpec);
+}
+//----< unmap on destruction >---------------------------------------
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+#ifdef _WIN32
+
+//----< map whole file, read only >----------------------------------
+
+bool MappedFile::open(const std::string& fileSpec)
+{
+  close();
+  HANDLE hFile = ::CreateFileA(
+    fileSpec.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+  );
+  if (hFile == INVALID_HANDLE_VALUE)
+    return false;
+  LARGE_INTEGER fileSize;
+  if (!::GetFileSizeEx(hFile, &fileSize))
+  {
+    ::CloseHandle(hFile);
+    return false;
+  }
+  _hFile = hFile;
+  _isOpen = true;
+  if (fileSize.QuadPart == 0)
+    return true;
+  _hMapping = ::CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (_hMapping == nullptr)
+  {
+    close();
+    return false;
+  }
+  void* pView = ::MapViewOfFile(_hMapping, FILE_MAP_READ, 0, 0, 0);
+  if (pView == nullptr)
+  {
+    close();
+    return false;
+  }
+  _pData = static_cast<const char*>(pView);
+  _size = static_cast<size_t>(fileSize.QuadPart);
+  return true;
+}
+//----< release view, mapping, and file handles >--------------------
+
+void MappedFile::close()
+{
+  if (_size > 0)
+    ::UnmapViewOfFile(_pData);
+  if (_hMapping != nullptr)
+    ::CloseHandle(_hMapping);
+  if (_hFile != INVALID_HANDLE_VALUE)
+    ::CloseHandle(_hFile);
+  _hMapping = nullptr;
+  _hFile = INVALID_HANDLE_VALUE;
+  _pData = emptyFile;
+  _size = 0;
+  _isOpen = false;
+}
+
+#else
+
+//----< map whole file, read only >----------------------------------
+
+bool MappedFile::open(const std::string& fileSpec)
+{
+  close();
+  int fd = ::open(fileSpec.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+  {
+    ::close(fd);
+    return false;
+  }
+  _isOpen = true;
+  if (info.st_size == 0)
+  {
+    ::close(fd);
+    return true;
+  }
+  void* pView = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);  // mapping keeps its own reference to the file
+  if (pView == MAP_FAILED)
+  {
+    _isOpen = false;
+    return false;
+  }
+  ::madvise(pView, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+  _pData = static_cast<const char*>(pView);
+  _size = static_cast<size_t>(info.st_size);
+  return true;
+}
+//----< release mapping >--------------------------------------------
+
+void MappedFile::close()
+{
+  if (_size > 0)
+    ::munmap(const_cast<char*>(_pData), _size);
+  _pData = emptyFile;
+  _size = 0;
+  _isOpen = false;
+}
+
+#endif
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_MAPPEDFILE
+
+#include <iostream>
+
+int main()
+{
+  std::cout << "\n  Testing MappedFile";
+  std::cout << "\n --------------------";
+
+  MappedFile file("../Tokenizer/MappedFile.cpp");
+  if (!file.isOpen())
+  {
+    std::cout << "\n  can't map file\n\n";
+    return 1;
+  }
+  std::cout << "\n  mapped " << file.size() << " bytes";
+  std::cout << "\n  first line: " << std::string(file.begin(), file.begin() + 40);
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,69 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+///////////////////////////////////////////////////////////////////////////////
+// MappedFile.h - read-only memory-mapped view of a source file             //
+// ver 1.0                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a MappedFile class that maps an entire file into
+* the address space of the process, read only.  Toker can attach to the
+* mapped bytes and scan them with pointer arithmetic instead of pulling
+* every character through std::istream::get().  Repeated runs over the
+* same tree are served from the OS page cache without copies.
+*
+* The mapping lives as long as the MappedFile instance, so any Toker
+* attached to it must not outlive it.
+*
+* Public Interface:
+* -----------------
+* MappedFile file("../Tokenizer/Tokenizer.cpp");
+* if (file.isOpen())
+*   toker.attach(file);
+*
+* Build Process:
+* --------------
+* Required Files: MappedFile.h, MappedFile.cpp
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+#include <string>
+
+namespace Scanner
+{
+  class MappedFile
+  {
+  public:
+    MappedFile();
+    MappedFile(const std::string& fileSpec);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+    bool open(const std::string& fileSpec);
+    void close();
+    bool isOpen() const { return _isOpen; }
+    const char* begin() const { return _pData; }
+    const char* end() const { return _pData + _size; }
+    size_t size() const { return _size; }
+  private:
+    const char* _pData;
+    size_t _size;
+    bool _isOpen;
+#ifdef _WIN32
+    void* _hFile;
+    void* _hMapping;
+#endif
+  };
+}
+#endif
@@ -0,0 +1,233 @@
+///////////////////////////////////////////////////////////////////////////////
+// ParallelToker.cpp - tokenizes one large buffer on several threads         //
+// ver 1.0                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* tokenize() makes about four chunks per thread, each at least
+* minChunkSize bytes, so threads that finish early pick up more work.
+* Each chunk's Toker reads one token past the end of its chunk and then
+* stops, but stays attached, so the stitcher can keep using it if the
+* next chunk's speculation turns out wrong.
+*
+* Build Process:
+* --------------
+* Required Files: ParallelToker.h, ParallelToker.cpp, Tokenizer.h, Tokenizer.cpp,
+*                 MappedFile.h, MappedFile.cpp, and the files Tokenizer requires
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "ParallelToker.h"
+#include "MappedFile.h"
+#include "CharScan.h"
+
+using namespace Scanner;
+
+/////////////////////////////////////////////////////////////////////
+// Chunk: one line aligned range [begin, end) and what its Toker found
+
+struct ParallelToker::Chunk
+{
+  size_t begin;
+  size_t end;
+  std::unique_ptr<Toker> pToker;      // attached to [begin, end of buffer)
+  std::vector<TokenRecord> toks;      // tokens that start in the chunk
+  TokenRecord overflow;               // first token after the chunk, if any
+  TokenRecord nextTok()               // continue past the chunk
+  {
+    TokenRecord record = pToker->getTokRecord();
+    record.text.offset += begin;
+    return record;
+  }
+};
+
+//----< number of threads, 0 for one per core >----------------------
+
+ParallelToker::ParallelToker(size_t numThreads, size_t minChunkSize)
+  : _numThreads(numThreads), _minChunkSize(std::max<size_t>(minChunkSize, 1))
+{
+  if (_numThreads == 0)
+    _numThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+//----< give a chunk's Toker the options of this ParallelToker >-----
+
+void ParallelToker::configure(Toker& toker)
+{
+  toker.returnComments(_doReturnComments);
+  toker.returnDirectives(_doReturnDirectives);
+  toker.useTableEngine(_useTableEngine);
+  if (_pSpecialTokens != nullptr)
+    toker.setSpecialTokens(_pSpecialTokens);
+}
+//----< speculatively tokenize one chunk, run on a pool thread >-----
+
+void ParallelToker::lexChunk(Chunk& chunk, const char* pBegin, const char* pEnd)
+{
+  chunk.pToker.reset(new Toker);
+  configure(*chunk.pToker);
+  chunk.pToker->attach(pBegin + chunk.begin, pEnd);
+  while (true)
+  {
+    TokenRecord record = chunk.nextTok();
+    if (record.empty())
+      break;
+    if (record.offset() >= chunk.end)
+    {
+      chunk.overflow = record;
+      break;
+    }
+    chunk.toks.push_back(record);
+  }
+}
+//----< tokenize [pBegin, pEnd), returns number of tokens >----------
+
+size_t ParallelToker::tokenize(const char* pBegin, const char* pEnd, std::vector<TokenRecord>& toks)
+{
+  toks.clear();
+  _chunkCount = 0;
+  _resyncCount = 0;
+  if (pBegin == nullptr || pEnd <= pBegin)
+    return 0;
+
+  // split at line starts
+
+  size_t size = pEnd - pBegin;
+  size_t wanted = std::max<size_t>(std::min(size / _minChunkSize, _numThreads * 4), 1);
+  std::vector<Chunk> chunks(1);
+  chunks[0].begin = 0;
+  for (size_t i = 1; i < wanted; ++i)
+  {
+    const char* pNewline = findNewline(pBegin + i * (size / wanted), pEnd);
+    if (pNewline == pEnd)
+      break;
+    size_t boundary = pNewline + 1 - pBegin;
+    if (boundary <= chunks.back().begin || boundary >= size)
+      continue;
+    chunks.back().end = boundary;
+    chunks.emplace_back();
+    chunks.back().begin = boundary;
+  }
+  chunks.back().end = size;
+  _chunkCount = chunks.size();
+
+  // lex the chunks speculatively
+
+  std::atomic<size_t> nextChunk(0);
+  auto worker = [&]() {
+    size_t i;
+    while ((i = nextChunk++) < chunks.size())
+      lexChunk(chunks[i], pBegin, pEnd);
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < std::min(_numThreads, chunks.size()); ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads)
+    thread.join();
+
+  // stitch, using the Toker known to be in sync to find where each
+  // chunk's speculation starts to agree with it
+
+  size_t inSync = 0;
+  toks.insert(toks.end(), chunks[0].toks.begin(), chunks[0].toks.end());
+  TokenRecord next = chunks[0].overflow;
+  size_t current = 1;
+  while (!next.empty())
+  {
+    while (current < chunks.size() && next.offset() >= chunks[current].end)
+    {
+      if (!chunks[current].toks.empty())
+        ++_resyncCount;              // no token of this chunk agreed
+      ++current;
+    }
+    Chunk& chunk = chunks[current];
+    auto iter = std::lower_bound(chunk.toks.begin(), chunk.toks.end(), next.offset(),
+      [](const TokenRecord& record, size_t offset) { return record.offset() < offset; });
+    if (current != inSync && iter != chunk.toks.end() && iter->offset() == next.offset()
+      && iter->text.size == next.text.size && iter->kind == next.kind)
+    {
+      if (iter != chunk.toks.begin())
+        ++_resyncCount;
+      toks.insert(toks.end(), iter, chunk.toks.end());
+      next = chunk.overflow;
+      inSync = current++;
+      continue;
+    }
+    toks.push_back(next);
+    next = chunks[inSync].nextTok();
+  }
+  return toks.size();
+}
+//----< tokenize a mapped file >-------------------------------------
+
+size_t ParallelToker::tokenize(const MappedFile& file, std::vector<TokenRecord>& toks)
+{
+  if (!file.isOpen())
+  {
+    toks.clear();
+    return 0;
+  }
+  return tokenize(file.begin(), file.end(), toks);
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_PARALLELTOKER
+
+#include <iostream>
+#include <sstream>
+#include "../Utilities/Utilities.h"
+
+int main(int argc, char* argv[])
+{
+  Utilities::StringHelper::Title("Testing ParallelToker");
+
+  std::string fileSpec = argc > 1 ? argv[1] : "../Tokenizer/Tokenizer.cpp";
+  MappedFile file(fileSpec);
+  if (!file.isOpen())
+  {
+    std::cout << "\n  can't open " << fileSpec << "\n\n";
+    return 1;
+  }
+
+  Toker toker;
+  toker.returnComments();
+  toker.attach(file);
+  std::vector<TokenRecord> serial;
+  for (TokenRecord record = toker.getTokRecord(); !record.empty(); record = toker.getTokRecord())
+    serial.push_back(record);
+
+  ParallelToker ptoker(4, 4096);    // small chunks, so comments and strings cross boundaries
+  ptoker.returnComments();
+  std::vector<TokenRecord> parallel;
+  ptoker.tokenize(file, parallel);
+
+  bool same = serial.size() == parallel.size();
+  for (size_t i = 0; same && i < serial.size(); ++i)
+  {
+    same = serial[i].offset() == parallel[i].offset() && serial[i].kind == parallel[i].kind
+      && serial[i].text.size == parallel[i].text.size;
+  }
+  std::cout << "\n  " << fileSpec << ": " << file.size() << " bytes, " << serial.size() << " tokens";
+  std::cout << "\n  " << ptoker.threadCount() << " threads, " << ptoker.chunkCount() << " chunks, "
+    << ptoker.resyncCount() << " chunks resynced";
+  std::cout << "\n  parallel tokens match serial tokens: " << std::boolalpha << same;
+  std::cout << "\n\n";
+  return same ? 0 : 1;
+}
+#endif
@@ -0,0 +1,97 @@
+#ifndef PARALLELTOKER_H
+#define PARALLELTOKER_H
+///////////////////////////////////////////////////////////////////////////////
+// ParallelToker.h - tokenizes one large buffer on several threads           //
+// ver 1.1                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a ParallelToker class that tokenizes a buffer,
+* usually a MappedFile, by splitting it into chunks that start at line
+* starts and running one Toker per chunk on a pool of threads.
+*
+* Each chunk's Toker starts speculatively, as if its first line began
+* outside any comment or string.  That's usually right.  When it isn't,
+* e.g., the chunk starts inside a block comment, the stitching pass
+* finds out and repairs it:
+* - chunk 0 is always right, and its Toker is "in sync" with a serial
+*   Toker
+* - the stitcher takes the next token from the Toker in sync, and if the
+*   speculative tokens of the chunk it falls in include the same token
+*   at the same offset, the two Tokers agree from there on.  The rest of
+*   that chunk is appended and its Toker becomes the one in sync.
+* - otherwise the token is appended and the Toker in sync keeps going,
+*   serially, until it reaches a token the chunks agree with.
+* A Toker's state at the start of a token depends only on the chars from
+* there on, so the result is exactly the serial Toker's token sequence.
+*
+* Tokens are TokenRecords whose text refers to the buffer, so the buffer
+* must outlive them.  Use Toker::lineOf(), or a LineIndex built on the
+* buffer, to find their lines.
+*
+* Public Interface:
+* -----------------
+* MappedFile file("huge.cpp");
+* ParallelToker ptoker;
+* ptoker.returnComments();
+* std::vector<TokenRecord> toks;
+* ptoker.tokenize(file, toks);
+* std::cout << ptoker.chunkCount() << " chunks, " << ptoker.resyncCount() << " resynced";
+*
+* Build Process:
+* --------------
+* Required Files: ParallelToker.h, ParallelToker.cpp, Tokenizer.h, Tokenizer.cpp,
+*                 MappedFile.h, MappedFile.cpp, and the files Tokenizer requires
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 18 Oct 2026
+* - added returnDirectives()
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+#include <memory>
+#include <vector>
+#include "Tokenizer.h"
+
+namespace Scanner
+{
+  class MappedFile;
+  class SpecialTokens;
+
+  class ParallelToker
+  {
+  public:
+    ParallelToker(size_t numThreads = 0, size_t minChunkSize = 1 << 20);
+    void returnComments(bool doReturnComments = true) { _doReturnComments = doReturnComments; }
+    void returnDirectives(bool doReturnDirectives = true) { _doReturnDirectives = doReturnDirectives; }
+    void useTableEngine(bool doUseTableEngine = true) { _useTableEngine = doUseTableEngine; }
+    void setSpecialTokens(std::shared_ptr<const SpecialTokens> pSpecialTokens) { _pSpecialTokens = pSpecialTokens; }
+    size_t tokenize(const char* pBegin, const char* pEnd, std::vector<TokenRecord>& toks);
+    size_t tokenize(const MappedFile& file, std::vector<TokenRecord>& toks);
+    size_t threadCount() const { return _numThreads; }
+    size_t chunkCount() const { return _chunkCount; }
+    size_t resyncCount() const { return _resyncCount; }
+  private:
+    struct Chunk;
+    void configure(Toker& toker);
+    void lexChunk(Chunk& chunk, const char* pBegin, const char* pEnd);
+    size_t _numThreads;
+    size_t _minChunkSize;
+    bool _doReturnComments = false;
+    bool _doReturnDirectives = false;
+    bool _useTableEngine = false;
+    std::shared_ptr<const SpecialTokens> _pSpecialTokens;
+    size_t _chunkCount = 0;
+    size_t _resyncCount = 0;   // chunks whose first tokens were relexed
+  };
+}
+#endif
@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+// SpecialTokens.cpp - compiled set of one and two char special tokens      //
+// ver 1.1                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Compiles a comma separated token list into bit sets.  The default set
+* is compiled on first use and shared by every Toker that doesn't call
+* setSpecialTokens().  The operator trie is also built on first use,
+* then only read.
+*
+* Build Process:
+* --------------
+* Required Files: SpecialTokens.h, SpecialTokens.cpp, Utilities.h, Utilities.cpp
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 18 Oct 2026
+* - added OperatorTrie
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include "SpecialTokens.h"
+#include "..\Utilities\Utilities.h"
+
+using namespace Scanner;
+
+//----< construct empty set >----------------------------------------
+
+SpecialTokens::SpecialTokens()
+{
+  std::fill(std::begin(_oneChar), std::end(_oneChar), 0);
+  std::fill(std::begin(_twoChar), std::end(_twoChar), 0);
+}
+//----< compile comma separated list, e.g., "<, >, <<, \n" >---------
+
+SpecialTokens::SpecialTokens(const std::string& commaSeparatedTokens) : SpecialTokens()
+{
+  for (const std::string& tok : Utilities::StringHelper::split(commaSeparatedTokens))
+    add(tok);
+}
+//----< set the bit for one token >----------------------------------
+
+void SpecialTokens::add(const std::string& tok)
+{
+  if (tok.size() == 1)
+  {
+    unsigned index = static_cast<unsigned char>(tok[0]);
+    _oneChar[index >> 6] |= uint64_t(1) << (index & 63);
+  }
+  else if (tok.size() == 2)
+  {
+    unsigned index = (static_cast<unsigned char>(tok[0]) << 8) | static_cast<unsigned char>(tok[1]);
+    _twoChar[index >> 6] |= uint64_t(1) << (index & 63);
+  }
+}
+//----< compile a set for sharing >----------------------------------
+
+SpecialTokens::Ptr SpecialTokens::compile(const std::string& commaSeparatedTokens)
+{
+  return std::make_shared<SpecialTokens>(commaSeparatedTokens);
+}
+//----< Toker's default special tokens, compiled once >--------------
+
+SpecialTokens::Ptr SpecialTokens::defaults()
+{
+  static const Ptr pDefaults = [] {
+    auto pTokens = std::make_shared<SpecialTokens>();
+    const char* tokens[] = {
+      "\n", "<", ">", "{", "}", "[", "]", "(", ")", ":", "=", "+", "-", "*", ".",
+      "<<", ">>", "::", "++", "--", "==", "+=", "-=", "*=", "/="
+    };
+    for (const char* tok : tokens)
+      pTokens->add(tok);
+    return Ptr(pTokens);
+  }();
+  return pDefaults;
+}
+//----< build trie of C++ operators and punctuators >---------------
+
+OperatorTrie::OperatorTrie() : _nodes(2)
+{
+  std::memset(_next, 0, sizeof(_next));
+  std::fill(std::begin(_isOperator), std::end(_isOperator), false);
+  const char* operators[] = {
+    "{", "}", "[", "]", "(", ")", ";", ":", "?", ",", "#", "##", "::", ".", ".*", "...",
+    "->", "->*", "~", "!", "+", "-", "*", "/", "%", "^", "&", "|", "=",
+    "+=", "-=", "*=", "/=", "%=", "^=", "&=", "|=", "==", "!=", "<", ">", "<=", ">=",
+    "&&", "||", "<<", ">>", "<<=", ">>=", "++", "--"
+  };
+  for (const char* op : operators)
+    add(op);
+}
+//----< add path for op, marking its last node >--------------------
+
+void OperatorTrie::add(const char* op)
+{
+  Node node = 1;
+  for (const char* pChar = op; *pChar != '\0'; ++pChar)
+  {
+    Node& child = _next[node][static_cast<unsigned char>(*pChar)];
+    if (child == 0)
+    {
+      if (_nodes == maxNodes)
+        throw(std::length_error("OperatorTrie has too many nodes"));
+      child = static_cast<Node>(_nodes++);
+    }
+    node = child;
+  }
+  _isOperator[node] = true;
+}
+//----< the trie, built once >---------------------------------------
+
+const OperatorTrie& OperatorTrie::cpp()
+{
+  static const OperatorTrie trie;  // function static initialization is thread safe
+  return trie;
+}
+//----< end of longest operator at pBegin, or pBegin + 1 if none >---
+/*
+ * Follows the rule of takes(), one char at a time, as stream input
+ * does, so buffer and stream input split operators alike.
+ */
+const char* OperatorTrie::munch(const char* pBegin, const char* pEnd) const
+{
+  Node node = first(static_cast<unsigned char>(*pBegin));
+  const char* pChar = pBegin + 1;
+  while (pChar < pEnd)
+  {
+    int chAfter = pChar + 1 < pEnd ? static_cast<unsigned char>(pChar[1]) : EOF;
+    if (!takes(node, static_cast<unsigned char>(*pChar), chAfter))
+      break;
+    node = next(node, static_cast<unsigned char>(*pChar));
+    ++pChar;
+  }
+  return pChar;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_SPECIALTOKENS
+
+#include <cctype>
+#include <iostream>
+
+int main()
+{
+  Utilities::StringHelper::Title("Testing SpecialTokens");
+
+  SpecialTokens::Ptr pDefaults = SpecialTokens::defaults();
+  std::cout << "\n  default one char tokens: ";
+  for (int ch = 0; ch < 256; ++ch)
+  {
+    if (pDefaults->isOneCharToken(ch))
+      std::cout << (ch == '\n' ? std::string("newline") : std::string(1, static_cast<char>(ch))) << " ";
+  }
+  std::cout << "\n  default two char tokens: ";
+  for (int first = 0; first < 256; ++first)
+    for (int second = 0; second < 256; ++second)
+      if (pDefaults->isTwoCharToken(first, second))
+        std::cout << static_cast<char>(first) << static_cast<char>(second) << " ";
+
+  SpecialTokens::Ptr pTokens = SpecialTokens::compile("., :, +, +=, \n { }");
+  std::cout << std::boolalpha;
+  std::cout << "\n\n  compiled \"., :, +, +=, \\n { }\"";
+  std::cout << "\n  '+' is one char token:  " << pTokens->isOneCharToken('+');
+  std::cout << "\n  '<' is one char token:  " << pTokens->isOneCharToken('<');
+  std::cout << "\n  \"+=\" is two char token: " << pTokens->isTwoCharToken('+', '=');
+  std::cout << "\n  \"::\" is two char token: " << pTokens->isTwoCharToken(':', ':');
+
+  std::cout << "\n\n  maximal munch of \"a->*b<<=c...d..e&&(f!=g);;\":\n  ";
+  std::string text = "a->*b<<=c...d..e&&(f!=g);;";
+  const char* pEnd = text.data() + text.size();
+  for (const char* pChar = text.data(); pChar < pEnd; )
+  {
+    const char* pStop = pChar + 1;
+    if (!std::isalpha(static_cast<unsigned char>(*pChar)))
+      pStop = OperatorTrie::cpp().munch(pChar, pEnd);
+    std::cout << "\"" << std::string(pChar, pStop) << "\" ";
+    pChar = pStop;
+  }
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,123 @@
+#ifndef SPECIALTOKENS_H
+#define SPECIALTOKENS_H
+///////////////////////////////////////////////////////////////////////////////
+// SpecialTokens.h - compiled set of one and two char special tokens        //
+// ver 1.1                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a SpecialTokens class that holds the one and two
+* char tokens Toker returns as single tokens.  The comma separated list
+* passed to Toker::setSpecialTokens() is compiled once into:
+* - a 256 bit set, one bit per one char token
+* - a 64K bit map, one bit per (first, second) char pair
+* so each lookup is a shift and a mask, with no string compares.
+*
+* A compiled set is immutable, so any number of Tokers, on any number of
+* threads, can share one through a SpecialTokens::Ptr.
+*
+* Items of more than two chars can never match and are ignored, as they
+* always were.
+*
+* OperatorTrie holds the C++ operators and punctuators, e.g., "->*",
+* "<<=", "...", and "&&", compiled once into a table with one row of
+* 128 child nodes per prefix.  munch() finds the longest operator at a
+* pointer by following one table entry per char, so every operator is
+* exactly one token.  Digraphs, like "<:", are not operators here.
+*
+* Public Interface:
+* -----------------
+* SpecialTokens::Ptr pTokens = SpecialTokens::compile("., :, +, +=, \n { }");
+* toker1.setSpecialTokens(pTokens);
+* toker2.setSpecialTokens(pTokens);
+* if (pTokens->isTwoCharToken('+', '='))
+*   doSomething();
+* const char* pEnd = OperatorTrie::cpp().munch(pChar, pBufferEnd);
+*
+* Build Process:
+* --------------
+* Required Files: SpecialTokens.h, SpecialTokens.cpp, Utilities.h, Utilities.cpp
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 18 Oct 2026
+* - added OperatorTrie, for maximal munch of C++ operators
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Scanner
+{
+  class SpecialTokens
+  {
+  public:
+    using Ptr = std::shared_ptr<const SpecialTokens>;
+    SpecialTokens();
+    explicit SpecialTokens(const std::string& commaSeparatedTokens);
+    static Ptr compile(const std::string& commaSeparatedTokens);
+    static Ptr defaults();
+    bool isOneCharToken(int ch) const
+    {
+      unsigned index = static_cast<unsigned char>(ch);
+      return ((_oneChar[index >> 6] >> (index & 63)) & 1) != 0;
+    }
+    bool isTwoCharToken(int first, int second) const
+    {
+      unsigned index = (static_cast<unsigned char>(first) << 8) | static_cast<unsigned char>(second);
+      return ((_twoChar[index >> 6] >> (index & 63)) & 1) != 0;
+    }
+  private:
+    void add(const std::string& tok);
+    uint64_t _oneChar[256 / 64];
+    uint64_t _twoChar[65536 / 64];
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // OperatorTrie: C++ operators and punctuators, for maximal munch
+
+  class OperatorTrie
+  {
+  public:
+    using Node = unsigned char;     // 0 is no node, 1 the root
+    static const OperatorTrie& cpp();
+    Node first(int ch) const { return next(1, ch); }
+    Node next(Node node, int ch) const
+    {
+      return ch >= 0 && ch < 128 ? _next[node][ch] : 0;
+    }
+    bool isOperator(Node node) const { return _isOperator[node]; }
+    bool takes(Node node, int ch, int chAfter) const;
+    const char* munch(const char* pBegin, const char* pEnd) const;
+  private:
+    static const size_t maxNodes = 64;
+    OperatorTrie();
+    void add(const char* op);
+    Node _next[maxNodes][128];
+    bool _isOperator[maxNodes];
+    size_t _nodes;
+  };
+
+  //----< does the operator at node go on with ch? >-----------------
+  /*
+   * A prefix that isn't itself an operator, "..", is taken only when
+   * chAfter completes it.  Every other prefix of a C++ operator is an
+   * operator, so one char of lookahead is enough.
+   */
+  inline bool OperatorTrie::takes(Node node, int ch, int chAfter) const
+  {
+    Node child = next(node, ch);
+    return child != 0 && (_isOperator[child] || _isOperator[next(child, chAfter)]);
+  }
+}
+#endif
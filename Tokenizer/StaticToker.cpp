@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// StaticToker.cpp - Toker specialized at compile time for one configuration //
+// ver 1.0                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* StaticToker is a template, defined in StaticToker.h.  This file
+* instantiates the default configuration, so the template is compiled
+* with the library, and holds the test stub.
+*
+* Build Process:
+* --------------
+* Required Files: StaticToker.h, StaticToker.cpp, Tokenizer.h, Tokenizer.cpp,
+*                 and the files Tokenizer requires
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+
+#include "StaticToker.h"
+
+template class Scanner::StaticToker<Scanner::CppTokenConfig>;
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_STATICTOKER
+
+#include <iostream>
+#include "../Utilities/Utilities.h"
+
+using namespace Scanner;
+
+struct CommentConfig : CppTokenConfig
+{
+  static const bool returnComments = true;
+};
+
+struct DirectiveConfig : CommentConfig
+{
+  static const bool returnDirectives = true;
+};
+
+//----< do StaticToker and Toker agree on every token? >-------------
+
+template <typename Config>
+bool sameAsToker(const MappedFile& file, bool doReturnComments, size_t& count)
+{
+  StaticToker<Config> staticToker;
+  staticToker.attach(file);
+  Toker toker;
+  toker.returnComments(doReturnComments);
+  toker.returnDirectives(Config::returnDirectives);
+  toker.attach(file);
+  count = 0;
+  while (true)
+  {
+    TokenRecord expected = toker.getTokRecord();
+    TokenRecord record = staticToker.getTokRecord();
+    if (expected.offset() != record.offset() || expected.text.size != record.text.size
+      || expected.kind != record.kind)
+      return false;
+    if (record.empty())
+      return staticToker.diagnosticCount() == toker.diagnosticCount();
+    ++count;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  Utilities::StringHelper::Title("Testing StaticToker");
+
+  std::string fileSpec = argc > 1 ? argv[1] : "../Tokenizer/Tokenizer.cpp";
+  MappedFile file(fileSpec);
+  if (!file.isOpen())
+  {
+    std::cout << "\n  can't open " << fileSpec << "\n\n";
+    return 1;
+  }
+
+  size_t count = 0;
+  bool same = sameAsToker<CppTokenConfig>(file, false, count);
+  std::cout << "\n  " << fileSpec << ": " << count << " tokens without comments, same as Toker: "
+    << std::boolalpha << same;
+  bool sameWithComments = sameAsToker<CommentConfig>(file, true, count);
+  std::cout << "\n  " << fileSpec << ": " << count << " tokens with comments, same as Toker: "
+    << sameWithComments;
+  bool sameWithDirectives = sameAsToker<DirectiveConfig>(file, true, count);
+  std::cout << "\n  " << fileSpec << ": " << count << " tokens with directives, same as Toker: "
+    << sameWithDirectives;
+
+  StaticToker<> toker;
+  toker.attach(file);
+  size_t shown = 0;
+  for (TokenRecord record = toker.getTokRecord(); !record.empty() && shown < 8; record = toker.getTokRecord())
+  {
+    if (record.kind == TokenKind::newline)
+      continue;
+    std::cout << "\n -- line " << toker.lineOf(record.offset()) << ", " << kindName(record.kind) << ": "
+      << record.text.str();
+    ++shown;
+  }
+  std::cout << "\n\n";
+  return same && sameWithComments && sameWithDirectives ? 0 : 1;
+}
+#endif
@@ -0,0 +1,365 @@
+#ifndef STATICTOKER_H
+#define STATICTOKER_H
+///////////////////////////////////////////////////////////////////////////////
+// StaticToker.h - Toker specialized at compile time for one configuration   //
+// ver 1.4                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a StaticToker<Config> class template that
+* tokenizes a buffer, usually a MappedFile, with a configuration fixed
+* at compile time.  Config is a class with static members:
+* - isOneCharToken(ch) and isTwoCharToken(first, second), usually
+*   switches, which the compiler turns into jump or bit tables
+* - returnComments and returnDirectives, constants, so the branches
+*   not taken are compiled away
+* - isKeyword(pTok, size), the keyword set
+* CppTokenConfig is Toker's default configuration.  Derive from it to
+* change only some members.
+*
+* For the same special tokens and comment setting, StaticToker returns
+* exactly the tokens, kinds, offsets, and diagnostics of Toker's buffer
+* input, but it has no states, no Context, and no virtual calls.  Toker
+* and its setSpecialTokens() remain the choice for stream input, ad-hoc
+* configurations, and skipping inactive regions.
+*
+* Public Interface:
+* -----------------
+* struct CommentConfig : CppTokenConfig { static const bool returnComments = true; };
+* StaticToker<CommentConfig> toker;
+* toker.attach(file);                        // MappedFile or buffer input
+* for (TokenRecord record = toker.getTokRecord(); !record.empty(); record = toker.getTokRecord())
+*   std::cout << toker.lineOf(record.offset()) << ": " << record.text.str();
+*
+* Build Process:
+* --------------
+* Required Files: StaticToker.h, StaticToker.cpp, Tokenizer.h, CharScan.h, CharScan.cpp,
+*                 SpecialTokens.h, SpecialTokens.cpp,
+*                 TokenTable.h, TokenTable.cpp, LineIndex.h, LineIndex.cpp,
+*                 MappedFile.h, MappedFile.cpp
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.4 : 18 Oct 2026
+* - added Config::returnDirectives, which returns each directive as one
+*   token, as Toker::returnDirectives() does
+* ver 1.3 : 18 Oct 2026
+* - operators are eaten by maximal munch with the OperatorTrie, as in
+*   Toker
+* ver 1.2 : 18 Oct 2026
+* - numbers and raw strings are single tokens, as in Toker
+* ver 1.1 : 18 Oct 2026
+* - quoted literals end at an unescaped line end, as in Toker
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+#include <vector>
+#include "Tokenizer.h"
+#include "CharScan.h"
+#include "SpecialTokens.h"
+#include "TokenTable.h"
+#include "LineIndex.h"
+#include "MappedFile.h"
+
+namespace Scanner
+{
+  /////////////////////////////////////////////////////////////////////
+  // CppTokenConfig: Toker's default special tokens, C++ keywords
+
+  struct CppTokenConfig
+  {
+    static const bool returnComments = false;
+    static const bool returnDirectives = false;
+    static bool isOneCharToken(int ch)
+    {
+      switch (ch)
+      {
+      case '\n': case '<': case '>': case '{': case '}': case '[': case ']':
+      case '(': case ')': case ':': case '=': case '+': case '-': case '*': case '.':
+        return true;
+      default:
+        return false;
+      }
+    }
+    static bool isTwoCharToken(int first, int second)
+    {
+      switch (first)
+      {
+      case '<':
+        return second == '<';
+      case '>':
+        return second == '>';
+      case ':':
+        return second == ':';
+      case '+':
+        return second == '+' || second == '=';
+      case '-':
+        return second == '-' || second == '=';
+      case '=': case '*': case '/':
+        return second == '=';
+      default:
+        return false;
+      }
+    }
+    static bool isKeyword(const char* pTok, size_t size)
+    {
+      return isKeywordId(fixedId(pTok, size));
+    }
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // StaticToker: buffer input Toker with a compile-time configuration
+
+  template <typename Config = CppTokenConfig>
+  class StaticToker
+  {
+  public:
+    bool attach(const char* pBegin, const char* pEnd);
+    bool attach(const MappedFile& file);
+    TokenRecord getTokRecord();
+    TokenView getTokView() { return getTokRecord().text; }
+    size_t lineOf(size_t offset);
+    const std::vector<TokenDiagnostic>& diagnostics() const { return _diagnostics; }
+    size_t diagnosticCount() const { return _diagnosticCount; }
+  private:
+    static int charAt(const char* pChar) { return static_cast<unsigned char>(*pChar); }
+    int prevChar(const char* pChar) const { return pChar > _pBegin ? charAt(pChar - 1) : 0; }
+    bool atLineStart(const char* pChar) const;
+    void addDiagnostic(const char* pChar, const char* message);
+    const char* eatIdent(const char* pChar);
+    const char* eatPunctuator(const char* pChar);
+    TokenKind wordKind(const char* pTok, size_t size);
+    static TokenKind punctuatorKind(int first, size_t size);
+    const char* _pBegin = nullptr;
+    const char* _pCur = nullptr;    // first char of the next token
+    const char* _pEnd = nullptr;
+    LineIndex _lines;
+    bool _linesBuilt = false;
+    std::vector<TokenDiagnostic> _diagnostics;
+    size_t _diagnosticCount = 0;
+  };
+
+  //----< attach to caller-owned buffer [pBegin, pEnd) >--------------
+
+  template <typename Config>
+  bool StaticToker<Config>::attach(const char* pBegin, const char* pEnd)
+  {
+    if (pBegin == nullptr || pEnd < pBegin)
+      return false;
+    _pBegin = pBegin;
+    _pEnd = pEnd;
+    _pCur = skipBlanks(pBegin, pEnd);
+    _lines.clear();
+    _linesBuilt = false;
+    _diagnostics.clear();
+    _diagnosticCount = 0;
+    return true;
+  }
+  //----< attach to memory-mapped file >------------------------------
+
+  template <typename Config>
+  bool StaticToker<Config>::attach(const MappedFile& file)
+  {
+    if (!file.isOpen())
+      return false;
+    return attach(file.begin(), file.end());
+  }
+  //----< record a malformed byte, keeping at most maxDiagnostics >---
+
+  template <typename Config>
+  void StaticToker<Config>::addDiagnostic(const char* pChar, const char* message)
+  {
+    if (_diagnostics.size() < Toker::maxDiagnostics)
+      _diagnostics.push_back(TokenDiagnostic{ static_cast<size_t>(pChar - _pBegin), message });
+    ++_diagnosticCount;
+  }
+  //----< end of identifier starting at pChar, same rules as Toker >--
+
+  template <typename Config>
+  const char* StaticToker<Config>::eatIdent(const char* pChar)
+  {
+    while (pChar < _pEnd)
+    {
+      int ch = charAt(pChar);
+      if (ch < 0x80)
+      {
+        if (!isIdentChar(ch))
+          break;
+        pChar = skipIdent(pChar, _pEnd);
+        continue;
+      }
+      if (!isUtf8Lead(ch))
+        break;
+      bool complete;
+      const char* pNext = skipUtf8(pChar, _pEnd, complete);
+      if (!complete)
+        addDiagnostic(pChar, "truncated UTF-8 sequence");
+      pChar = pNext;
+    }
+    return pChar;
+  }
+  //----< end of operator or punctuator starting at pChar >----------
+
+  template <typename Config>
+  const char* StaticToker<Config>::eatPunctuator(const char* pChar)
+  {
+    const char* pStop = OperatorTrie::cpp().munch(pChar, _pEnd);
+    if (pStop == pChar + 1 && pStop < _pEnd && Config::isTwoCharToken(charAt(pChar), charAt(pStop)))
+      ++pStop;
+    return pStop;
+  }
+  //----< kind of a token collected as an identifier >----------------
+
+  template <typename Config>
+  TokenKind StaticToker<Config>::wordKind(const char* pTok, size_t size)
+  {
+    if (*pTok >= '0' && *pTok <= '9')
+      return TokenKind::number;
+    if (Config::isKeyword(pTok, size))
+      return TokenKind::keyword;
+    return TokenKind::identifier;
+  }
+  //----< kind of a punctuator or special char token >---------------
+
+  template <typename Config>
+  TokenKind StaticToker<Config>::punctuatorKind(int first, size_t size)
+  {
+    if (size == 1 && first == '\n')
+      return TokenKind::newline;
+    if (size == 1 && first == '#')
+      return TokenKind::preprocHash;
+    return TokenKind::punctuator;
+  }
+  //----< is *pChar the first non-blank char of its line? >-----------
+
+  template <typename Config>
+  bool StaticToker<Config>::atLineStart(const char* pChar) const
+  {
+    while (pChar > _pBegin && isBlankChar(charAt(pChar - 1)))
+      --pChar;
+    return pChar == _pBegin || pChar[-1] == '\n';
+  }
+  //----< next token, empty record at end of input >------------------
+  /*
+   * The tests are made in the order of ConsumeState::nextState(), and
+   * each branch scans what the state of the same name would eat.
+   */
+  template <typename Config>
+  TokenRecord StaticToker<Config>::getTokRecord()
+  {
+    TokenRecord record;
+    const char* pChar = _pCur;
+    while (pChar < _pEnd)
+    {
+      const char* pStart = pChar;
+      int ch = charAt(pChar);
+      int chNext = pChar + 1 < _pEnd ? charAt(pChar + 1) : EOF;
+      if (ch == '.' && isDigitChar(chNext))
+      {
+        pChar = skipNumber(pChar, _pEnd);
+        record.kind = TokenKind::number;
+      }
+      else if (Config::isOneCharToken(ch) && !isPunctChar(ch))
+      {
+        pChar += (chNext != EOF && Config::isTwoCharToken(ch, chNext)) ? 2 : 1;
+        record.kind = punctuatorKind(ch, pChar - pStart);
+      }
+      else if (isBlankChar(ch))
+      {
+        pChar = skipBlanks(pChar + 1, _pEnd);
+        continue;
+      }
+      else if (ch == '/' && chNext == '/')
+      {
+        pChar = findNewline(pChar + 1, _pEnd);
+        if (!Config::returnComments)
+          continue;
+        record.kind = TokenKind::comment;
+      }
+      else if (ch == '/' && chNext == '*')
+      {
+        const char* pStar = findCommentEnd(pChar + 1, _pEnd);
+        pChar = pStar + 1 < _pEnd ? pStar + 2 : _pEnd;
+        if (!Config::returnComments)
+          continue;
+        record.kind = TokenKind::comment;
+      }
+      else if (isDigitChar(ch))
+      {
+        pChar = skipNumber(pChar, _pEnd);
+        record.kind = TokenKind::number;
+      }
+      else if (isIdentChar(ch) || isUtf8Lead(ch))
+      {
+        pChar = eatIdent(pChar);
+        record.kind = wordKind(pStart, pChar - pStart);
+        if (pChar < _pEnd && *pChar == '\"' && isRawPrefix(pStart, pChar - pStart))
+        {
+          bool complete;
+          const char* pStop = findRawLiteralEnd(pChar, _pEnd, complete);
+          if (!complete)
+            addDiagnostic(pStart, pStop < _pEnd ? "invalid raw string delimiter" : "unterminated raw string literal");
+          pChar = pStop;
+          record.kind = TokenKind::stringLiteral;
+        }
+      }
+      else if ((ch == '\"' || ch == '\'') && prevChar(pChar) != '\\')
+      {
+        pChar = findLiteralEnd(pChar + 1, _pEnd, static_cast<char>(ch));
+        if (pChar < _pEnd && charAt(pChar) == ch)
+          ++pChar;
+        else
+          addDiagnostic(pStart, ch == '\"' ? "unterminated string literal" : "unterminated char literal");
+        record.kind = ch == '\"' ? TokenKind::stringLiteral : TokenKind::charLiteral;
+      }
+      else if (Config::returnDirectives && ch == '#' && atLineStart(pChar))
+      {
+        const char* pTextEnd = findDirectiveEnd(pChar, _pEnd, pChar);
+        record.text.pData = pStart;
+        record.text.size = pTextEnd - pStart;
+        record.text.offset = pStart - _pBegin;
+        record.kind = TokenKind::directive;
+        break;
+      }
+      else if (isPunctChar(ch))
+      {
+        pChar = eatPunctuator(pChar);
+        record.kind = punctuatorKind(ch, pChar - pStart);
+      }
+      else
+      {
+        if (ch != '\n')
+          addDiagnostic(pChar, ch >= 0x80 ? "invalid UTF-8 byte" : "control character");
+        pChar = skipBlanks(pChar + 1, _pEnd);
+        continue;
+      }
+      record.text.pData = pStart;
+      record.text.size = pChar - pStart;
+      record.text.offset = pStart - _pBegin;
+      break;
+    }
+    _pCur = pChar;
+    return record;
+  }
+  //----< line of the char at offset, indexed on first use >----------
+
+  template <typename Config>
+  size_t StaticToker<Config>::lineOf(size_t offset)
+  {
+    if (!_linesBuilt && _pBegin != nullptr)
+    {
+      _lines.build(_pBegin, _pEnd);
+      _linesBuilt = true;
+    }
+    return _lines.lineOf(offset);
+  }
+}
+#endif
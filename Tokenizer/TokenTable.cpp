@@ -0,0 +1,303 @@
+///////////////////////////////////////////////////////////////////////////////
+// TokenTable.cpp - interns token spellings as dense 32 bit ids              //
+// ver 1.1                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Fixed ids are found by binary search of a table sorted on first use.
+* Dynamic ids are spread over the shards by the high bits of a hash of
+* the spelling, and encode their shard, so spelling() knows where to
+* look:  id = Tok::fixedCount + index in shard * numShards + shard.
+*
+* Build Process:
+* --------------
+* Required Files: TokenTable.h, TokenTable.cpp
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 18 Oct 2026
+* - fixed ids for "!=", "<=", and ">="
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "TokenTable.h"
+
+using namespace Scanner;
+
+namespace
+{
+  struct FixedToken
+  {
+    const char* spelling;
+    size_t size;
+    TokenId id;
+  };
+
+#define SCANNER_TOKEN_SPELLING(name, spelling) spelling,
+  const char* const fixedSpellings[] = {
+    "",
+    SCANNER_KEYWORD_TOKENS(SCANNER_TOKEN_SPELLING)
+    SCANNER_OTHER_TOKENS(SCANNER_TOKEN_SPELLING)
+  };
+#undef SCANNER_TOKEN_SPELLING
+  static_assert(sizeof(fixedSpellings) / sizeof(fixedSpellings[0]) == Tok::fixedCount,
+    "one spelling for each fixed id");
+
+  int compare(const char* pLeft, size_t leftSize, const char* pRight, size_t rightSize)
+  {
+    int cmp = std::memcmp(pLeft, pRight, std::min(leftSize, rightSize));
+    if (cmp != 0)
+      return cmp;
+    return leftSize < rightSize ? -1 : (leftSize > rightSize ? 1 : 0);
+  }
+
+  uint32_t hashOf(const char* pTok, size_t size)   // FNV-1a
+  {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i)
+      hash = (hash ^ static_cast<unsigned char>(pTok[i])) * 16777619u;
+    return hash;
+  }
+
+  struct Key
+  {
+    const char* pTok;
+    size_t size;
+    uint32_t hash;
+    bool operator==(const Key& key) const
+    {
+      return size == key.size && std::memcmp(pTok, key.pTok, size) == 0;
+    }
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(const Key& key) const { return key.hash; }
+  };
+
+  const size_t blockSize = 64 * 1024;
+}
+
+//----< fixed id of a keyword, listed punctuator, or Tok::none >-----
+
+TokenId Scanner::fixedId(const char* pTok, size_t size)
+{
+  static const std::vector<FixedToken> sorted = [] {
+    std::vector<FixedToken> tokens;
+    for (TokenId id = 1; id < Tok::fixedCount; ++id)
+      tokens.push_back({ fixedSpellings[id], std::strlen(fixedSpellings[id]), id });
+    std::sort(tokens.begin(), tokens.end(), [](const FixedToken& left, const FixedToken& right) {
+      return compare(left.spelling, left.size, right.spelling, right.size) < 0;
+    });
+    return tokens;
+  }();
+  if (size == 0 || size > 16)
+    return Tok::none;
+  auto iter = std::lower_bound(sorted.begin(), sorted.end(), size,
+    [pTok](const FixedToken& token, size_t size) {
+      return compare(token.spelling, token.size, pTok, size) < 0;
+    });
+  if (iter != sorted.end() && compare(iter->spelling, iter->size, pTok, size) == 0)
+    return iter->id;
+  return Tok::none;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Shard: one lock, its ids, and the blocks holding their spellings
+
+struct TokenTable::Shard
+{
+  mutable std::mutex lock;
+  std::unordered_map<Key, TokenId, KeyHash> ids;
+  std::vector<Key> keys;                  // indexed by id / numShards
+  std::vector<std::unique_ptr<char[]>> blocks;
+  size_t blockUsed = blockSize;
+  size_t bytes = 0;
+  size_t overflows = 0;
+  size_t maxIds = 0;
+  size_t maxBytes = 0;
+  const char* store(const char* pTok, size_t size)
+  {
+    if (blockUsed + size > blockSize)
+    {
+      blocks.emplace_back(new char[blockSize]);
+      blockUsed = 0;
+    }
+    char* pCopy = blocks.back().get() + blockUsed;
+    std::memcpy(pCopy, pTok, size);
+    blockUsed += size;
+    bytes += size;
+    return pCopy;
+  }
+};
+
+//----< construct with limits on dynamic ids and spelling bytes >----
+
+TokenTable::TokenTable(size_t maxIds, size_t maxBytes) : _pShards(new Shard[numShards])
+{
+  for (size_t i = 0; i < numShards; ++i)
+  {
+    _pShards[i].maxIds = maxIds / numShards;
+    _pShards[i].maxBytes = maxBytes / numShards;
+  }
+}
+
+TokenTable::~TokenTable() {}
+
+//----< table shared by all SemiExps >-------------------------------
+
+TokenTable& TokenTable::global()
+{
+  static TokenTable table;
+  return table;
+}
+//----< id of spelling, adding it if new, Tok::none if no room >-----
+
+TokenId TokenTable::intern(const char* pTok, size_t size)
+{
+  TokenId id = fixedId(pTok, size);
+  if (id != Tok::none || size == 0 || size > maxTokenSize)
+    return id;
+  Key key = { pTok, size, hashOf(pTok, size) };
+  size_t shardIndex = key.hash >> 28;
+  Shard& shard = _pShards[shardIndex];
+  std::lock_guard<std::mutex> guard(shard.lock);
+  auto iter = shard.ids.find(key);
+  if (iter != shard.ids.end())
+    return iter->second;
+  if (shard.keys.size() >= shard.maxIds || shard.bytes + size > shard.maxBytes)
+  {
+    ++shard.overflows;
+    return Tok::none;
+  }
+  key.pTok = shard.store(pTok, size);
+  id = static_cast<TokenId>(Tok::fixedCount + shard.keys.size() * numShards + shardIndex);
+  shard.keys.push_back(key);
+  shard.ids[key] = id;
+  return id;
+}
+//----< id of spelling if already interned, else Tok::none >---------
+
+TokenId TokenTable::find(const char* pTok, size_t size) const
+{
+  TokenId id = fixedId(pTok, size);
+  if (id != Tok::none || size == 0 || size > maxTokenSize)
+    return id;
+  Key key = { pTok, size, hashOf(pTok, size) };
+  const Shard& shard = _pShards[key.hash >> 28];
+  std::lock_guard<std::mutex> guard(shard.lock);
+  auto iter = shard.ids.find(key);
+  return iter == shard.ids.end() ? Tok::none : iter->second;
+}
+//----< text of an id, empty for Tok::none and unknown ids >---------
+
+std::string TokenTable::spelling(TokenId id) const
+{
+  if (id < Tok::fixedCount)
+    return fixedSpellings[id];
+  const Shard& shard = _pShards[(id - Tok::fixedCount) % numShards];
+  size_t index = (id - Tok::fixedCount) / numShards;
+  std::lock_guard<std::mutex> guard(shard.lock);
+  if (index >= shard.keys.size())
+    return "";
+  return std::string(shard.keys[index].pTok, shard.keys[index].size);
+}
+//----< number of ids in use >---------------------------------------
+
+size_t TokenTable::size() const
+{
+  size_t count = Tok::fixedCount;
+  for (size_t i = 0; i < numShards; ++i)
+  {
+    std::lock_guard<std::mutex> guard(_pShards[i].lock);
+    count += _pShards[i].keys.size();
+  }
+  return count;
+}
+//----< bytes of spelling text held >--------------------------------
+
+size_t TokenTable::bytes() const
+{
+  size_t count = 0;
+  for (size_t i = 0; i < numShards; ++i)
+  {
+    std::lock_guard<std::mutex> guard(_pShards[i].lock);
+    count += _pShards[i].bytes;
+  }
+  return count;
+}
+//----< number of spellings refused because the table was full >-----
+
+size_t TokenTable::overflows() const
+{
+  size_t count = 0;
+  for (size_t i = 0; i < numShards; ++i)
+  {
+    std::lock_guard<std::mutex> guard(_pShards[i].lock);
+    count += _pShards[i].overflows;
+  }
+  return count;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TOKENTABLE
+
+#include <iostream>
+#include <thread>
+#include "../Utilities/Utilities.h"
+
+int main()
+{
+  Utilities::StringHelper::Title("Testing TokenTable");
+
+  TokenTable& table = TokenTable::global();
+  std::cout << "\n  " << Tok::fixedCount - 1 << " fixed ids";
+  std::cout << "\n  intern(\"for\") == Tok::kw_for: " << std::boolalpha
+    << (table.intern("for") == Tok::kw_for);
+  std::cout << "\n  intern(\"::\") == Tok::scope:   " << (table.intern("::") == Tok::scope);
+  TokenId id = table.intern("myFunction");
+  std::cout << "\n  intern(\"myFunction\") = " << id << ", spelling \"" << table.spelling(id) << "\"";
+  std::cout << "\n  interned again, same id: " << (table.intern("myFunction") == id);
+  std::cout << "\n  find(\"notInterned\") = " << table.find("notInterned");
+
+  std::cout << "\n\n  four threads intern the same 1000 spellings";
+  std::vector<std::vector<TokenId>> ids(4);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < ids.size(); ++t)
+  {
+    threads.emplace_back([&table, &ids, t] {
+      for (size_t i = 0; i < 1000; ++i)
+        ids[t].push_back(table.intern("name" + std::to_string(i)));
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  bool same = true;
+  for (auto& threadIds : ids)
+    same = same && threadIds == ids[0];
+  std::cout << "\n  all threads got the same ids: " << same;
+  std::cout << "\n  table holds " << table.size() << " ids, " << table.bytes() << " bytes";
+
+  TokenTable small(32, 4096);
+  for (size_t i = 0; i < 100; ++i)
+    small.intern("name" + std::to_string(i));
+  std::cout << "\n\n  table limited to 32 ids holds " << small.size() - Tok::fixedCount
+    << " dynamic ids, refused " << small.overflows();
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,155 @@
+#ifndef TOKENTABLE_H
+#define TOKENTABLE_H
+///////////////////////////////////////////////////////////////////////////////
+// TokenTable.h - interns token spellings as dense 32 bit ids                //
+// ver 1.1                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a TokenTable class that maps each distinct token
+* spelling to a TokenId, so clients can compare tokens with an integer
+* compare instead of a string compare.
+*
+* The C++ keywords, the punctuators the parser rules look for, and "std"
+* have fixed ids, the Tok:: constants, known at compile time:
+*   if (tc.id(i) == Tok::lbrace) ...
+* Fixed ids are the same for every table, and fixedId() finds them with
+* a binary search of a constant table, with no locking.
+*
+* Other spellings get ids from intern() in the order they are first
+* seen.  The table is split into shards, each with its own lock, so the
+* Tokers and SemiExps of many files can intern on separate threads.
+* Spellings are copied into large blocks, not one allocation each.
+*
+* Memory is bounded: a table holds at most maxIds dynamic ids and
+* maxBytes of spelling text, and spellings longer than maxTokenSize are
+* never interned.  When a spelling can't be interned intern() returns
+* Tok::none, and clients fall back to comparing text.
+*
+* Public Interface:
+* -----------------
+* TokenTable& table = TokenTable::global();
+* TokenId id = table.intern("myFunction");
+* if (table.intern("for") == Tok::kw_for) ...
+* std::string text = table.spelling(id);
+* if (isKeywordId(fixedId(pTok, size))) ...
+*
+* Build Process:
+* --------------
+* Required Files: TokenTable.h, TokenTable.cpp
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 18 Oct 2026
+* - added fixed ids for "!=", "<=", and ">=", now single tokens
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace Scanner
+{
+  using TokenId = uint32_t;
+
+  // name, spelling - keywords first, in sorted order
+
+#define SCANNER_KEYWORD_TOKENS(X) \
+  X(kw_alignas, "alignas") X(kw_alignof, "alignof") X(kw_and, "and") \
+  X(kw_and_eq, "and_eq") X(kw_asm, "asm") X(kw_auto, "auto") \
+  X(kw_bitand, "bitand") X(kw_bitor, "bitor") X(kw_bool, "bool") \
+  X(kw_break, "break") X(kw_case, "case") X(kw_catch, "catch") \
+  X(kw_char, "char") X(kw_char16_t, "char16_t") X(kw_char32_t, "char32_t") \
+  X(kw_class, "class") X(kw_compl, "compl") X(kw_const, "const") \
+  X(kw_const_cast, "const_cast") X(kw_constexpr, "constexpr") \
+  X(kw_continue, "continue") X(kw_decltype, "decltype") \
+  X(kw_default, "default") X(kw_delete, "delete") X(kw_do, "do") \
+  X(kw_double, "double") X(kw_dynamic_cast, "dynamic_cast") \
+  X(kw_else, "else") X(kw_enum, "enum") X(kw_explicit, "explicit") \
+  X(kw_export, "export") X(kw_extern, "extern") X(kw_false, "false") \
+  X(kw_float, "float") X(kw_for, "for") X(kw_friend, "friend") \
+  X(kw_goto, "goto") X(kw_if, "if") X(kw_inline, "inline") X(kw_int, "int") \
+  X(kw_long, "long") X(kw_mutable, "mutable") X(kw_namespace, "namespace") \
+  X(kw_new, "new") X(kw_noexcept, "noexcept") X(kw_not, "not") \
+  X(kw_not_eq, "not_eq") X(kw_nullptr, "nullptr") X(kw_operator, "operator") \
+  X(kw_or, "or") X(kw_or_eq, "or_eq") X(kw_private, "private") \
+  X(kw_protected, "protected") X(kw_public, "public") \
+  X(kw_register, "register") X(kw_reinterpret_cast, "reinterpret_cast") \
+  X(kw_return, "return") X(kw_short, "short") X(kw_signed, "signed") \
+  X(kw_sizeof, "sizeof") X(kw_static, "static") \
+  X(kw_static_assert, "static_assert") X(kw_static_cast, "static_cast") \
+  X(kw_struct, "struct") X(kw_switch, "switch") X(kw_template, "template") \
+  X(kw_this, "this") X(kw_thread_local, "thread_local") X(kw_throw, "throw") \
+  X(kw_true, "true") X(kw_try, "try") X(kw_typedef, "typedef") \
+  X(kw_typeid, "typeid") X(kw_typename, "typename") X(kw_union, "union") \
+  X(kw_unsigned, "unsigned") X(kw_using, "using") X(kw_virtual, "virtual") \
+  X(kw_void, "void") X(kw_volatile, "volatile") X(kw_wchar_t, "wchar_t") \
+  X(kw_while, "while") X(kw_xor, "xor") X(kw_xor_eq, "xor_eq")
+
+#define SCANNER_OTHER_TOKENS(X) \
+  X(lbrace, "{") X(rbrace, "}") X(lparen, "(") X(rparen, ")") \
+  X(lbracket, "[") X(rbracket, "]") X(less, "<") X(greater, ">") \
+  X(semicolon, ";") X(colon, ":") X(scope, "::") X(assign, "=") \
+  X(equal, "==") X(notEqual, "!=") X(lessEqual, "<=") X(greaterEqual, ">=") \
+  X(comma, ",") X(dot, ".") X(arrow, "->") X(star, "*") \
+  X(amp, "&") X(tilde, "~") X(plusPlus, "++") X(minusMinus, "--") \
+  X(shiftLeft, "<<") X(shiftRight, ">>") X(hash, "#") X(newline, "\n") \
+  X(id_std, "std")
+
+  namespace Tok
+  {
+#define SCANNER_TOKEN_ENUM(name, spelling) name,
+    enum : TokenId
+    {
+      none = 0,
+      SCANNER_KEYWORD_TOKENS(SCANNER_TOKEN_ENUM)
+      SCANNER_OTHER_TOKENS(SCANNER_TOKEN_ENUM)
+      fixedCount,
+      firstKeyword = kw_alignas,
+      lastKeyword = kw_xor_eq
+    };
+#undef SCANNER_TOKEN_ENUM
+  }
+
+  inline bool isKeywordId(TokenId id)
+  {
+    return id >= Tok::firstKeyword && id <= Tok::lastKeyword;
+  }
+
+  TokenId fixedId(const char* pTok, size_t size);
+  inline TokenId fixedId(const std::string& tok) { return fixedId(tok.data(), tok.size()); }
+
+  class TokenTable
+  {
+  public:
+    static const size_t maxTokenSize = 255;
+    TokenTable(size_t maxIds = size_t(1) << 22, size_t maxBytes = size_t(64) << 20);
+    ~TokenTable();
+    TokenTable(const TokenTable&) = delete;
+    TokenTable& operator=(const TokenTable&) = delete;
+    static TokenTable& global();
+    TokenId intern(const char* pTok, size_t size);
+    TokenId intern(const std::string& tok) { return intern(tok.data(), tok.size()); }
+    TokenId find(const char* pTok, size_t size) const;
+    TokenId find(const std::string& tok) const { return find(tok.data(), tok.size()); }
+    std::string spelling(TokenId id) const;
+    size_t size() const;      // fixed and dynamic ids
+    size_t bytes() const;     // spelling text held
+    size_t overflows() const; // intern() calls refused for lack of room
+  private:
+    struct Shard;
+    static const size_t numShards = 16;
+    std::unique_ptr<Shard[]> _pShards;
+  };
+}
+#endif
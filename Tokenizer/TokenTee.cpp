@@ -0,0 +1,298 @@
+///////////////////////////////////////////////////////////////////////////////
+// TokenTee.cpp - shares one Toker's token batches with several clients      //
+// ver 1.0                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* The tee holds its lock only while the Toker lexes a batch or finds a
+* line, not while it calls clients or waits for a queue, so a queue's
+* client can call lineOf() while the tee waits for it to make room.
+*
+* A queue copies each batch it holds.  A client that takes a whole
+* batch gets it by swap, so only batches split by a smaller max are
+* copied again.
+*
+* Build Process:
+* --------------
+* Required Files: TokenTee.h, TokenTee.cpp, Tokenizer.h, Tokenizer.cpp,
+*                 and the files Tokenizer requires
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include "TokenTee.h"
+
+using namespace Scanner;
+
+//----< queue for one client of tee >--------------------------------
+
+TokenQueue::TokenQueue(TokenTee& tee, size_t maxBatches)
+  : _tee(tee), _maxBatches(std::max<size_t>(maxBatches, 1)) {}
+
+//----< next tokens, up to max, waits until tee has lexed them >-----
+/*
+ * Returns 0 at the end of input, or after close().
+ */
+size_t TokenQueue::getToks(TokenBuffer& buffer, size_t max)
+{
+  buffer.clear();
+  std::unique_lock<std::mutex> lock(_mutex);
+  _canRead.wait(lock, [this] { return !_batches.empty() || _finished || _closed; });
+  if (_batches.empty() || _closed || max == 0)
+    return 0;
+  TokenBuffer& front = _batches.front();
+  if (_frontPos == 0 && front.size() <= max)
+    std::swap(buffer, front);
+  else
+  {
+    size_t count = std::min(max, front.size() - _frontPos);
+    buffer.append(front, _frontPos, count);
+    _frontPos += count;
+    if (_frontPos < front.size())
+      return buffer.size();
+  }
+  _batches.pop_front();
+  _frontPos = 0;
+  _canWrite.notify_one();
+  return buffer.size();
+}
+//----< line of a token this queue returned >------------------------
+
+size_t TokenQueue::lineOf(size_t offset)
+{
+  return _tee.lineOf(offset);
+}
+//----< stop reading, so the tee no longer waits for this client >---
+
+void TokenQueue::close()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _closed = true;
+  _batches.clear();
+  _canRead.notify_all();
+  _canWrite.notify_all();
+}
+//----< tee: add a batch, waiting while the queue is full >----------
+
+void TokenQueue::push(const TokenBuffer& batch)
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _canWrite.wait(lock, [this] { return _batches.size() < _maxBatches || _closed; });
+  if (_closed)
+    return;
+  _batches.push_back(batch);
+  _canRead.notify_one();
+}
+//----< tee: end of input, readers get 0 once the queue is empty >---
+
+void TokenQueue::finish()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _finished = true;
+  _canRead.notify_all();
+}
+
+//----< share toker's tokens, run() lexes batchSize at a time >------
+
+TokenTee::TokenTee(Toker& toker, size_t batchSize)
+  : _toker(toker), _batchSize(std::max<size_t>(batchSize, 1)) {}
+
+//----< end of input for queues still waiting on this tee >----------
+
+TokenTee::~TokenTee()
+{
+  for (auto& pQueue : _queues)
+    pQueue->finish();
+}
+//----< call pConsumer with every batch, on the lexing thread >------
+
+void TokenTee::addConsumer(ITokenConsumer* pConsumer)
+{
+  _consumers.push_back(pConsumer);
+}
+//----< queue of every batch, for a client on another thread >-------
+
+std::shared_ptr<TokenQueue> TokenTee::addQueue(size_t maxBatches)
+{
+  std::shared_ptr<TokenQueue> pQueue = std::make_shared<TokenQueue>(*this, maxBatches);
+  _queues.push_back(pQueue);
+  return pQueue;
+}
+//----< lex next batch, pass it to every client, then return it >----
+/*
+ * Each token is lexed once, by this call, however many clients get
+ * it.  The first call that reaches the end of input finishes the
+ * clients.
+ */
+size_t TokenTee::getToks(TokenBuffer& buffer, size_t max)
+{
+  buffer.clear();
+  if (_finished || max == 0)
+    return 0;
+  size_t count;
+  {
+    std::lock_guard<std::mutex> lock(_tokerMutex);
+    count = _toker.getToks(buffer, max);
+  }
+  if (count == 0)
+  {
+    finish();
+    return 0;
+  }
+  _tokenCount += count;
+  for (ITokenConsumer* pConsumer : _consumers)
+    pConsumer->consume(buffer);
+  for (auto& pQueue : _queues)
+    pQueue->push(buffer);
+  return count;
+}
+//----< line of a token, safe to call from any client's thread >-----
+
+size_t TokenTee::lineOf(size_t offset)
+{
+  std::lock_guard<std::mutex> lock(_tokerMutex);
+  return _toker.lineOf(offset);
+}
+//----< lex the rest of the input for the clients, returns count >---
+
+size_t TokenTee::run()
+{
+  while (getToks(_batch, _batchSize) > 0)
+    ;
+  _batch.clear();
+  return _tokenCount;
+}
+//----< share the reattached Toker's input, keeping the consumers >--
+/*
+ * Queues belong to one input, so they are dropped.  Add new ones for
+ * the next.
+ */
+void TokenTee::restart()
+{
+  for (auto& pQueue : _queues)
+    pQueue->finish();
+  _queues.clear();
+  _batch.clear();
+  _tokenCount = 0;
+  _finished = false;
+}
+//----< tell every client there are no more batches >----------------
+
+void TokenTee::finish()
+{
+  _finished = true;
+  for (ITokenConsumer* pConsumer : _consumers)
+    pConsumer->finish();
+  for (auto& pQueue : _queues)
+    pQueue->finish();
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TOKENTEE
+
+#include <iostream>
+#include <thread>
+#include "MappedFile.h"
+#include "../Utilities/Utilities.h"
+
+//----< same thread client: counts tokens of each kind >-------------
+
+class KindCounter : public ITokenConsumer
+{
+public:
+  void consume(const TokenBuffer& batch) override
+  {
+    for (size_t i = 0; i < batch.size(); ++i)
+      ++_counts[static_cast<size_t>(batch[i].kind)];
+  }
+  void finish() override { _finished = true; }
+  size_t count(TokenKind kind) const { return _counts[static_cast<size_t>(kind)]; }
+  bool finished() const { return _finished; }
+private:
+  size_t _counts[16] = {};
+  bool _finished = false;
+};
+
+int main(int argc, char* argv[])
+{
+  Utilities::StringHelper::Title("Testing TokenTee");
+
+  std::string fileSpec = argc > 1 ? argv[1] : "../Tokenizer/Tokenizer.cpp";
+  MappedFile file(fileSpec);
+  if (!file.isOpen())
+  {
+    std::cout << "\n  can't open " << fileSpec << "\n\n";
+    return 1;
+  }
+
+  Toker reference;
+  reference.attach(file);
+  std::vector<TokenRecord> expected;
+  for (TokenRecord record = reference.getTokRecord(); !record.empty(); record = reference.getTokRecord())
+    expected.push_back(record);
+
+  Toker toker;
+  toker.attach(file);
+  TokenTee tee(toker);
+  KindCounter counter;
+  tee.addConsumer(&counter);
+
+  // two queue clients: one reads whole batches, one reads 5 at a time
+
+  bool sameInQueue[2] = { false, false };
+  size_t lastLine = 0;
+  std::vector<std::thread> clients;
+  for (size_t client = 0; client < 2; ++client)
+  {
+    std::shared_ptr<TokenQueue> pQueue = tee.addQueue(2);
+    size_t max = client == 0 ? TokenTee::defaultBatchSize : 5;
+    clients.emplace_back([&, pQueue, client, max]() {
+      TokenBuffer batch;
+      size_t n = 0;
+      bool same = true;
+      while (pQueue->getToks(batch, max) > 0)
+      {
+        for (size_t i = 0; i < batch.size(); ++i, ++n)
+          same = same && n < expected.size() && batch[i].offset() == expected[n].offset()
+            && batch[i].text.size == expected[n].text.size;
+        if (client == 1)
+          lastLine = pQueue->lineOf(batch[batch.size() - 1].offset());
+      }
+      sameInQueue[client] = same && n == expected.size();
+    });
+  }
+
+  // this thread drives the pass, as a SemiExp reading the tee would
+
+  TokenBuffer batch;
+  size_t pulled = 0;
+  while (tee.getToks(batch, 64) > 0)
+    pulled += batch.size();
+  for (auto& client : clients)
+    client.join();
+  bool sameInQueues = sameInQueue[0] && sameInQueue[1];
+
+  std::cout << "\n  " << fileSpec << ": " << tee.tokenCount() << " tokens lexed once, "
+    << expected.size() << " from a Toker of its own";
+  std::cout << "\n  same thread client: " << counter.count(TokenKind::identifier) << " identifiers, "
+    << counter.count(TokenKind::keyword) << " keywords, finished: " << std::boolalpha << counter.finished();
+  std::cout << "\n  queued clients got the same tokens: " << sameInQueues << ", last line " << lastLine;
+  bool same = sameInQueues && pulled == expected.size() && tee.tokenCount() == expected.size()
+    && counter.finished();
+  std::cout << "\n\n";
+  return same ? 0 : 1;
+}
+#endif
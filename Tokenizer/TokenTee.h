@@ -0,0 +1,139 @@
+#ifndef TOKENTEE_H
+#define TOKENTEE_H
+///////////////////////////////////////////////////////////////////////////////
+// TokenTee.h - shares one Toker's token batches with several clients        //
+// ver 1.0                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a TokenTee class that lexes its input once, with
+* one Toker, and hands every batch of tokens to each registered client:
+* - an ITokenConsumer, e.g., a metrics counter or an indexer, is called
+*   with each batch on the thread that lexes it
+* - a TokenQueue, from addQueue(), holds a few batches for a client on
+*   another thread.  It is an ITokenSource, so a SemiExp and Parser can
+*   read it.  The tee waits while a queue is full, so memory stays
+*   bounded and a slow client slows the lexing, but never repeats it.
+*
+* The tee is itself an ITokenSource.  Each getToks() lexes the next
+* batch, passes it on, and returns it, so a SemiExp reading the tee
+* drives the pass.  Without one, run() lexes to the end of input.
+*
+* Batches refer to the Toker's input just as Toker::getToks() batches
+* do, so buffer input must outlive every client.  TokenQueue::lineOf()
+* asks the Toker, under the tee's lock, so the tee must outlive the
+* threads that read its queues.  With IByteSource input the Toker
+* keeps only its most recent lines, so a queue's client should not lag
+* far behind.
+*
+* Public Interface:
+* -----------------
+* Toker toker;
+* toker.attach(file);
+* TokenTee tee(toker);
+* tee.addConsumer(&lineCounter);           // ITokenConsumer
+* std::shared_ptr<TokenQueue> pQueue = tee.addQueue();
+* std::thread indexer([&] { TokenBuffer batch; while (pQueue->getToks(batch, 64) > 0) index(batch); });
+* SemiExp semi(&tee);                      // parser drives the one pass
+* while (semi.get()) ...;
+* indexer.join();
+*
+* Build Process:
+* --------------
+* Required Files: TokenTee.h, TokenTee.cpp, Tokenizer.h, Tokenizer.cpp,
+*                 and the files Tokenizer requires
+*
+* Build Command: devenv Tokenizer.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Tokenizer.h"
+
+namespace Scanner
+{
+  class TokenTee;
+
+  /////////////////////////////////////////////////////////////////////
+  // ITokenConsumer: a client the tee calls with each batch
+  // - finish() is called once, at the end of input
+
+  class ITokenConsumer
+  {
+  public:
+    virtual ~ITokenConsumer() {}
+    virtual void consume(const TokenBuffer& batch) = 0;
+    virtual void finish() {}
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // TokenQueue: bounded queue of batches, read on another thread
+
+  class TokenQueue : public ITokenSource
+  {
+  public:
+    TokenQueue(TokenTee& tee, size_t maxBatches);
+    TokenQueue(const TokenQueue&) = delete;
+    TokenQueue& operator=(const TokenQueue&) = delete;
+    size_t getToks(TokenBuffer& buffer, size_t max) override;  // waits for a batch
+    size_t lineOf(size_t offset) override;
+    void close();         // client stops reading, later batches are dropped
+  private:
+    friend class TokenTee;
+    void push(const TokenBuffer& batch);
+    void finish();
+    TokenTee& _tee;
+    size_t _maxBatches;
+    std::deque<TokenBuffer> _batches;
+    size_t _frontPos = 0;        // tokens of _batches.front() read
+    bool _finished = false;      // no more batches will be pushed
+    bool _closed = false;
+    std::mutex _mutex;
+    std::condition_variable _canRead;
+    std::condition_variable _canWrite;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // TokenTee: one lexing pass, every batch shared with all clients
+
+  class TokenTee : public ITokenSource
+  {
+  public:
+    static const size_t defaultBatchSize = 64;
+    TokenTee(Toker& toker, size_t batchSize = defaultBatchSize);
+    TokenTee(const TokenTee&) = delete;
+    TokenTee& operator=(const TokenTee&) = delete;
+    ~TokenTee();
+    void addConsumer(ITokenConsumer* pConsumer);
+    std::shared_ptr<TokenQueue> addQueue(size_t maxBatches = 4);
+    size_t getToks(TokenBuffer& buffer, size_t max) override;
+    size_t lineOf(size_t offset) override;
+    size_t run();
+    void restart();       // after Toker is reattached, drops the queues
+    size_t tokenCount() const { return _tokenCount; }
+  private:
+    void finish();
+    Toker& _toker;
+    size_t _batchSize;
+    std::vector<ITokenConsumer*> _consumers;
+    std::vector<std::shared_ptr<TokenQueue>> _queues;
+    TokenBuffer _batch;          // used by run()
+    size_t _tokenCount = 0;
+    bool _finished = false;
+    std::mutex _tokerMutex;      // Toker is lexing, or finding a line
+  };
+}
+#endif
@@ -22,14 +22,130 @@
 * This is a new version, based on the State Design Pattern.  Older versions
 * exist, based on an informal state machine design.
 *
+* Toker can also attach to a caller-owned buffer or a MappedFile.  Then
+* the states scan the bytes directly with pointer arithmetic, but still
+* return exactly the tokens and line counts of the stream input.
+*
+* Toker::useTableEngine() switches to a TableLexer that replaces the
+* virtual state objects with a char class table and a switch.  Both
+* engines return identical token sequences.
+*
+* Toker::getTokView() returns a TokenView, a pointer, size, and offset,
+* instead of a std::string.  For buffer input it points into the buffer,
+* so a token costs no allocation or copy.  The states only note where
+* a buffered token ends, and getTok() copies it into a string.
+*
+* Toker::getTokRecord() returns the view with a TokenKind tag, e.g.,
+* keyword, punctuator, or comment, set by the state that ate the token,
+* so clients don't have to re-examine the text to classify it.
+*
+* Toker::getToks() collects up to max tokens into a TokenBuffer in one
+* call, so clients that want many tokens, like SemiExp, make one call
+* per batch instead of one per token.
+*
+* Both engines classify chars without locale calls or exceptions.  A
+* UTF-8 sequence is an identifier char, checked by a small DFA in the
+* Context, and a malformed byte is recorded as a TokenDiagnostic and
+* skipped as if it were whitespace, so bad input costs nothing extra.
+*
+* With recordComments(), each comment state's token is also recorded
+* as a CommentSpan.  Buffer input records only the offset and size,
+* stream input also keeps the text, which can't be read again.
+*
 * Build Process:
 * --------------
-* Required Files: Tokenizer.h, Tokenizer.cpp
+* Required Files: Tokenizer.h, Tokenizer.cpp, MappedFile.h, MappedFile.cpp,
+*                 CharScan.h, CharScan.cpp, SpecialTokens.h, SpecialTokens.cpp,
+*                 TokenTable.h, TokenTable.cpp, LineIndex.h, LineIndex.cpp,
+*                 ByteSource.h, ByteSource.cpp, Conditionals.h, Conditionals.cpp
 *
 * Build Command: devenv Tokenizer.sln /rebuild debug
 *
 * Maintenance History:
 * --------------------
+* ver 6.6 : 18 Oct 2026
+* - buffer input states no longer copy the token into Context::token.
+*   They record its size, views and batches point into the buffer, and
+*   tokenText() copies it only for getTok().
+* ver 6.5 : 18 Oct 2026
+* - defined Toker's static constants out of class, so std::max and
+*   other reference parameters can take them
+* ver 6.4 : 18 Oct 2026
+* - source input keeps recorded comments within a quarter of
+*   memoryLimit, dropping the oldest.  The read window is a quarter.
+* ver 6.3 : 18 Oct 2026
+* - skipInactive() follows comments, literals, and splices in the
+*   skipped text, so a #endif inside a comment doesn't end the region
+* ver 6.2 : 18 Oct 2026
+* - source input no longer throws on a token longer than its share of
+*   memoryLimit.  elideToken() drops the token's middle and reports it.
+* ver 6.1 : 18 Oct 2026
+* - both engines record a checkpoint, when asked, at the first token
+*   boundary each interval, and Context::restore() resumes from one
+* ver 6.0 : 18 Oct 2026
+* - added TokenBuffer::append()
+* ver 5.9 : 18 Oct 2026
+* - added EatDirective, and TableLexer's eatDirective, which eat a
+*   whole directive when returnDirectives() is on.  Context tracks
+*   whether currChar starts its line, for stream input as it collects.
+* ver 5.8 : 18 Oct 2026
+* - EatPunctuator, and TableLexer's eatPunctuator, eat one operator by
+*   maximal munch with the OperatorTrie, instead of a run of punctuator
+*   chars.  Special tokens that are punctuators add to the operators.
+* ver 5.7 : 18 Oct 2026
+* - added EatNumber, and TableLexer's eatNumber, which eat a whole
+*   preprocessing number.  EatAlphanum goes on to eat a raw string
+*   when the identifier is its prefix.
+* - added Context::peekInToken(), so lookahead at the end of input
+*   doesn't end it early
+* ver 5.6 : 18 Oct 2026
+* - quoted literals end at an unescaped line end.  eatLiteral(), shared
+*   by both engines, tracks escapes with a flag instead of isEscapted(),
+*   which copied the token and rescanned it for every char.
+* ver 5.5 : 18 Oct 2026
+* - testLog() takes a const char*.  Its std::string parameter cost
+*   the states engine a heap allocation for most tokens.
+* ver 5.4 : 18 Oct 2026
+* - added recordComments(), which records comment spans.  Buffered
+*   comments are copied into the token only when they are returned.
+* ver 5.3 : 18 Oct 2026
+* - nextState() no longer throws logic_error.  Chars are classified
+*   without locale calls, UTF-8 sequences are eaten by EatAlphanum,
+*   and malformed bytes are reported by diagnostics().
+* ver 4.9 : 18 Oct 2026
+* - tokens carry offsets only.  Line numbers come from a LineIndex:
+*   buffer input indexes its newlines in one pass when a line is first
+*   requested, so the lexer no longer counts them.  Added lineOf().
+* - attach() restarts the line count
+* ver 4.8 : 18 Oct 2026
+* - added TokenBuffer and getToks(), which collects a batch of tokens
+*   with their kinds and line counts in one call
+* ver 4.7 : 18 Oct 2026
+* - keywords are recognized with the fixed ids of TokenTable
+* ver 4.6 : 18 Oct 2026
+* - added TokenKind and getTokRecord().  Each state tags the tokens it
+*   eats, and classifyToken() tags tokens that arrive as strings.
+* ver 4.5 : 18 Oct 2026
+* - setSpecialTokens() compiles the list into an immutable SpecialTokens
+*   bit set, replacing the linear string searches.  Compiled sets can be
+*   shared between Tokers with setSpecialTokens(SpecialTokens::Ptr).
+* ver 4.4 : 18 Oct 2026
+* - added getTokView(), which returns a TokenView into the attached
+*   buffer instead of a new std::string, with the token's offset
+* - collectChar() returns false when it reaches the end of input, so
+*   comments and strings that end the input no longer end with EOF
+* ver 4.3 : 18 Oct 2026
+* - buffered whitespace, identifier, comment, and string scans use the
+*   SSE2/AVX2 run scanners in CharScan, chosen at run time
+* ver 4.2 : 18 Oct 2026
+* - added useTableEngine(), a table driven engine that classifies chars
+*   with a 256 entry table and runs the states from one switch, with no
+*   virtual dispatch or locale lookups.  It returns the same tokens as
+*   the ConsumeState classes.  See TokenizerBenchmark for a comparison.
+* ver 4.1 : 18 Oct 2026
+* - added attach(pBegin, pEnd) and attach(MappedFile) for buffer input.
+*   Buffered states scan runs with memchr and pointer loops instead of
+*   collecting one char at a time through the stream.
 * ver 4/0 : 17 Feb 2016
 * - modified EatDQString::eatChars() and EatSQString::eatChars() to properly
 *   handle repetition of escape char, '\', using isEscaped(tok) function.
@@ -71,17 +187,24 @@
 *
 * Planned Additions and Changes:
 * ------------------------------
-* - merge the oneCharacter and twoCharacter special Tokens into a
-*   single collection with a single setter method.
-* - consider replacing std::vector containers for special characteres
-*   with an unordered_map (hash table).
+* - none yet
 */
 
 #include <iostream>
+#include <algorithm>
+#include <stdexcept>
 #include <cctype>
+#include <cstring>
 #include <string>
 #include <vector>
 #include "Tokenizer.h"
+#include "MappedFile.h"
+#include "CharScan.h"
+#include "SpecialTokens.h"
+#include "TokenTable.h"
+#include "LineIndex.h"
+#include "ByteSource.h"
+#include "Conditionals.h"
 #include "..\Utilities\Utilities.h"
 
 namespace Scanner
@@ -96,33 +219,93 @@ namespace Scanner
    *   and we use a struct.  This won't be appropriate if we handed
    *   the context to clients of Toker.
    */
+  class TableLexer;      // table-driven alternative to the states
+
   struct Context
   {
     Context();
     ~Context();
-    std::string token;
+    bool isBuffered() { return _pIn == nullptr && _pSource == nullptr; }
+    void restart();
+    bool good();
+    int peek();
+    int peekInToken();
+    void clearEof();
+    bool collectChar();
+    bool refill();
+    void elideToken();
+    void collectThrough(const char* pLast);
+    bool checkConditionals();
+    void skipInactive();
+    void checkpoint();
+    bool restore(const TokenCheckpoint& checkpoint);
+    size_t currOffset();
+    void addDiagnostic(size_t offset, const char* message);
+    bool collectsComments() { return _doReturnComments || (_doRecordComments && !isBuffered()); }
+    void recordComment(CommentKind kind);
+    void dropOldComments();
+    bool continuesIdent(int ch);
+    bool atLineStart();
+    size_t lineCount();
+    size_t lineOf(size_t offset);
+    TokenView tokenView();
+    const std::string& tokenText();
+    void clearToken() { token.clear(); _tokenSize = 0; }
+    size_t tokenSize() { return isBuffered() ? _tokenSize : token.size(); }
+    void endToken(const char* pStop) { _tokenSize = pStop - (_pBegin + _tokenOffset); }
+    void takeChar();
+    std::string token;     // stream input: the token, buffer input: filled by tokenText()
+    size_t _tokenSize;     // buffer input: token is _tokenSize chars at _tokenOffset
+    size_t _tokenOffset;   // offset of first char of token
+    TokenKind _tokenKind;  // set by the state that collected token
     std::istream* _pIn;
-    std::vector<std::string> _oneCharTokens =
-    {
-      "\n", "<", ">", "{", "}", "[", "]", "(", ")", ":", "=", "+", "-", "*", "."
-    };
-    std::vector<std::string> _twoCharTokens =
-    {
-      "<<", ">>", "::", "++", "--", "==", "+=", "-=", "*=", "/="
-    };
+    IByteSource* _pSource;   // source input: reads into _window
+    std::vector<char> _window;
+    size_t _maxTokenSize;
+    size_t _elidedOffset;  // source input: offset of the last token elideToken() cut
+    size_t _charCount;     // stream input: chars collected
+    const char* _pBegin;   // buffer input: first char
+    const char* _pCur;     // buffer or source input: next char to collect
+    const char* _pEnd;     // buffer or source input: one past last char
+    bool _eof;             // buffer input: mirrors istream eofbit
+    SpecialTokens::Ptr _pSpecialTokens;
+    Conditionals::Ptr _pConditionals;  // null unless skipping inactive regions
+    ConditionStack _conditions;
+    const char* _pLastDirective;       // last directive applied to _conditions
+    const char* _pSkipFrom;            // start of an inactive region, after its directive's line
     int prevChar;
     int currChar;
+    int _utf8Remaining;    // continuation bytes still expected
+    int _utf8Lo;           // range of the next continuation byte
+    int _utf8Hi;
+    size_t _utf8LeadOffset;
+    std::vector<TokenDiagnostic> _diagnostics;
+    size_t _diagnosticCount;
     bool _doReturnComments;
-    size_t _lineCount;
+    bool _doRecordComments;
+    bool _doReturnDirectives;
+    bool _lineStart;       // stream input: only blanks precede currChar on its line
+    std::vector<CommentSpan> _comments;
+    std::string _commentText;             // stream input: text of _comments
+    std::vector<size_t> _commentTextPos;  // stream input: where each starts
+    size_t _maxCommentMemory;             // source input: bound on the three above
+    LineIndex _lines;      // stream input: newlines collected so far
+    bool _linesBuilt;      // buffer input: _lines indexes the buffer
+    size_t _checkpointInterval;           // 0 unless recording checkpoints
+    std::vector<TokenCheckpoint> _checkpoints;
     ConsumeState* _pState;
     ConsumeState* _pEatCppComment;
     ConsumeState* _pEatCComment;
     ConsumeState* _pEatWhitespace;
     ConsumeState* _pEatPunctuator;
     ConsumeState* _pEatAlphanum;
+    ConsumeState* _pEatNumber;
     ConsumeState* _pEatSpecialCharacters;
     ConsumeState* _pEatDQString;
     ConsumeState* _pEatSQString;
+    ConsumeState* _pEatDirective;
+    TableLexer* _pTableLexer;
+    bool _useTableEngine;
   };
 
   ///////////////////////////////////////////////////////////////////
@@ -148,32 +331,54 @@ namespace Scanner
     ConsumeState(const ConsumeState&) = delete;
     ConsumeState& operator=(const ConsumeState&) = delete;
     virtual ~ConsumeState();
-    void attach(std::istream* pIn) { _pContext->_pIn = pIn; }
+    void attach(std::istream* pIn);
+    void attach(const char* pBegin, const char* pEnd);
+    void attach(IByteSource* pSource, size_t bufferSize, size_t maxTokenSize, size_t maxNewlines, size_t maxCommentMemory);
     virtual void eatChars() = 0;
+    virtual TokenKind tokenKind() { return TokenKind::none; }
     void consumeChars() {
+      _pContext->_tokenOffset = _pContext->currOffset();
       _pContext->_pState->eatChars();
+      _pContext->_tokenKind = _pContext->_pState->tokenKind();
+      if (_pContext->_tokenKind == TokenKind::comment && _pContext->_doRecordComments)
+        _pContext->recordComment(_pContext->_pState == _pContext->_pEatCComment ? CommentKind::cComment : CommentKind::cppComment);
       _pContext->_pState = nextState();
     }
-    bool canRead() { return _pContext->_pIn->good(); }
-    std::string getTok() { return _pContext->token; }
-    bool hasTok() { return _pContext->token.size() > 0; }
+    bool canRead() { return good(); }
+    std::string getTok() { return _pContext->tokenText(); }
+    bool hasTok() { return _pContext->tokenSize() > 0; }
     ConsumeState* nextState();
     void returnComments(bool doReturnComments = false);
+    void returnDirectives(bool doReturnDirectives = false);
     size_t currentLineCount();
     void setSpecialTokens(const std::string& commaSeparatedString);
+    void setSpecialTokens(SpecialTokens::Ptr pSpecialTokens);
     void setContext(Context* pContext);
   protected:
     Context* _pContext;
-    bool collectChar();
-    bool isOneCharToken(Token tok);
-    bool isTwoCharToken(Token tok);
-    Token makeString(int ch);
+    bool isBuffered() { return _pContext->isBuffered(); }
+    bool good() { return _pContext->good(); }
+    int peek() { return _pContext->peek(); }
+    void clearEof() { _pContext->clearEof(); }
+    bool collectChar() { return _pContext->collectChar(); }
+    void collectThrough(const char* pLast) { _pContext->collectThrough(pLast); }
+    bool isOneCharToken(int ch) { return _pContext->_pSpecialTokens->isOneCharToken(ch); }
+    bool isTwoCharToken(int first, int second) { return _pContext->_pSpecialTokens->isTwoCharToken(first, second); }
   };
 }
 
 using namespace Scanner;
 using Token = std::string;
 
+//----< message for a byte that can't start a token >---------------
+/*
+ * A newline that isn't a special token is skipped without a message.
+ */
+inline const char* invalidCharMessage(int ch)
+{
+  return ch >= 0x80 ? "invalid UTF-8 byte" : "control character";
+}
+
 //----< used by Toker to provide Consumer with Context ptr >---------
 
 void ConsumeState::setContext(Context* pContext)
@@ -184,91 +389,511 @@ void ConsumeState::setContext(Context* pContext)
 
 void ConsumeState::setSpecialTokens(const std::string& commaSeparatedTokens)
 {
-  std::vector<Token> result = Utilities::StringHelper::split(commaSeparatedTokens);
-  _pContext->_oneCharTokens.clear();
-  _pContext->_twoCharTokens.clear();
-  for (std::string item : result)
+  _pContext->_pSpecialTokens = SpecialTokens::compile(commaSeparatedTokens);
+}
+//----< share an already compiled set, null restores the defaults >-
+
+void ConsumeState::setSpecialTokens(SpecialTokens::Ptr pSpecialTokens)
+{
+  if (pSpecialTokens == nullptr)
+    pSpecialTokens = SpecialTokens::defaults();
+  _pContext->_pSpecialTokens = pSpecialTokens;
+}
+//----< return number of newlines collected from stream >------------
+
+size_t ConsumeState::currentLineCount() { return _pContext->lineCount(); }
+
+//----< read from stream >-------------------------------------------
+
+void ConsumeState::attach(std::istream* pIn)
+{
+  _pContext->restart();
+  _pContext->_pIn = pIn;
+  _pContext->_pSource = nullptr;
+  _pContext->_pBegin = nullptr;
+  _pContext->_pCur = nullptr;
+  _pContext->_pEnd = nullptr;
+  _pContext->_lines.setCapacity(0);
+}
+//----< read from caller-owned buffer [pBegin, pEnd) >---------------
+
+void ConsumeState::attach(const char* pBegin, const char* pEnd)
+{
+  _pContext->restart();
+  _pContext->_pIn = nullptr;
+  _pContext->_pSource = nullptr;
+  _pContext->_pBegin = pBegin;
+  _pContext->_pCur = pBegin;
+  _pContext->_pEnd = pEnd;
+  _pContext->_lines.setCapacity(0);
+}
+//----< read from source through a window of bufferSize chars >------
+/*
+ * Memory stays bounded however long the input is:
+ * - the window is refilled in place, never grown
+ * - a token longer than maxTokenSize keeps its first and last chars,
+ *   at least 128 in all, and loses its middle
+ * - the line index keeps only the most recent maxNewlines newlines
+ * - recorded comments keep only the most recent maxCommentMemory bytes
+ */
+void ConsumeState::attach(IByteSource* pSource, size_t bufferSize, size_t maxTokenSize, size_t maxNewlines, size_t maxCommentMemory)
+{
+  _pContext->restart();
+  _pContext->_pIn = nullptr;
+  _pContext->_pSource = pSource;
+  if (_pContext->_window.size() != std::max<size_t>(bufferSize, 1))
   {
-    if (item.size() == 1 || item == "\n")
-      _pContext->_oneCharTokens.push_back(item);
-    if (item.size() >= 2)
-      _pContext->_twoCharTokens.push_back(item);
+    _pContext->_window.assign(std::max<size_t>(bufferSize, 1), 0);
+    _pContext->_window.shrink_to_fit();
   }
+  _pContext->_maxTokenSize = std::max<size_t>(maxTokenSize, 128);
+  _pContext->_pBegin = nullptr;
+  _pContext->_pCur = _pContext->_window.data();
+  _pContext->_pEnd = _pContext->_window.data();
+  _pContext->_lines.setCapacity(maxNewlines);
+  _pContext->_maxCommentMemory = maxCommentMemory;
 }
-//----< return number of newlines collected from stream >------------
+//----< is the input still readable? >-------------------------------
+/*
+ * Buffer input reproduces the istream state flags exactly, so both
+ * sources produce the same tokens and line counts:
+ * - get() or peek() past the last char sets _eof
+ * - clearEof() plays the role of std::istream::clear()
+ */
+bool Context::good()
+{
+  if (isBuffered())
+    return _pCur != nullptr && !_eof;
+  if (_pSource != nullptr)
+    return !_eof;
+  return _pIn->good();
+}
+//----< look at next char without collecting it >--------------------
 
-size_t ConsumeState::currentLineCount() { return _pContext->_lineCount; }
+int Context::peek()
+{
+  if (_pIn != nullptr)
+    return _pIn->peek();
+  if (_eof)
+    return EOF;
+  if (_pCur < _pEnd || (_pSource != nullptr && refill()))
+    return static_cast<unsigned char>(*_pCur);
+  _eof = true;
+  return EOF;
+}
+//----< peek() for lookahead inside a token, keeping input good >----
+/*
+ * A peek() that meets the end of input sets eof, so the char that
+ * ends the token would not be collected.
+ */
+int Context::peekInToken()
+{
+  int ch = peek();
+  if (ch == EOF)
+    clearEof();
+  return ch;
+}
+//----< reset end of input flag >------------------------------------
 
+void Context::clearEof()
+{
+  if (_pIn == nullptr)
+    _eof = false;
+  else
+    _pIn->clear();
+}
 //----< collect character from stream >------------------------------
-
-bool ConsumeState::collectChar()
+/*
+ * Returns false when there is no char to collect, including the
+ * attempt that runs into the end of input.  Earlier versions returned
+ * true there, and the states appended EOF to comments and strings
+ * that ended the input.
+ */
+bool Context::collectChar()
+{
+  if (!good())
+    return false;
+  prevChar = currChar;
+  if (isBuffered())
+  {
+    if (_pCur < _pEnd)
+      currChar = static_cast<unsigned char>(*_pCur++);
+    else
+    {
+      _eof = true;
+      currChar = EOF;
+      return false;
+    }
+  }
+  else
+  {
+    if (_charCount > 0)
+      _lineStart = currChar == '\n' || (_lineStart && isBlankChar(currChar));
+    if (_pSource == nullptr)
+      currChar = _pIn->get();
+    else if (_pCur < _pEnd || refill())
+      currChar = static_cast<unsigned char>(*_pCur++);
+    else
+    {
+      _eof = true;
+      currChar = EOF;
+    }
+    if (currChar == EOF)
+      return false;
+    if (currChar == '\n')
+      _lines.addNewline(_charCount);
+    ++_charCount;
+    if (_pSource != nullptr && token.size() > _maxTokenSize)
+      elideToken();
+  }
+  return true;
+}
+//----< source input: drop the middle of a token too long to keep >-
+/*
+ * Keeps the first half of _maxTokenSize chars and the last quarter, so
+ * the token's kind, and the tail a raw string compares with its
+ * delimiter, are unchanged.  Each cut moves only that quarter, and the
+ * token is reported once.
+ */
+void Context::elideToken()
+{
+  size_t head = _maxTokenSize / 2;
+  size_t tail = _maxTokenSize / 4;
+  token.erase(head, token.size() - head - tail);
+  if (_elidedOffset != _tokenOffset)
+  {
+    _elidedOffset = _tokenOffset;
+    addDiagnostic(_tokenOffset, "token longer than the memory limit, its middle was dropped");
+  }
+}
+//----< source input: replace window contents, false at end >-------
+/*
+ * Every char in the window has been collected, and the states keep
+ * their own copy of the token, so the window is simply overwritten.
+ */
+bool Context::refill()
+{
+  size_t count = _pSource->read(_window.data(), _window.size());
+  _pCur = _window.data();
+  _pEnd = _pCur + count;
+  return count > 0;
+}
+//----< buffer input: collect every char up to and including *pLast >
+/*
+ * Leaves prevChar, currChar, and end of input flag exactly as a
+ * sequence of collectChar() calls would.  pLast == _pEnd collects the
+ * end of input.
+ */
+void Context::collectThrough(const char* pLast)
+{
+  const char* pCur = _pCur;
+  if (pLast > pCur)
+    prevChar = static_cast<unsigned char>(pLast[-1]);
+  else
+    prevChar = currChar;
+  if (pLast < _pEnd)
+  {
+    currChar = static_cast<unsigned char>(*pLast);
+    _pCur = pLast + 1;
+  }
+  else
+  {
+    currChar = EOF;
+    _pCur = _pEnd;
+    _eof = true;
+  }
+}
+//----< buffer input: apply directives, skip inactive regions >------
+/*
+ * Called before each state runs, when currChar starts the next token.
+ * A directive line is tokenized as usual, so the parser still sees
+ * its #if, #else, or #endif.  When its group turns inactive, the skip
+ * happens at the first token that starts after the line.  Returns
+ * true if currChar moved, so the caller must choose the state again.
+ */
+bool Context::checkConditionals()
 {
-  if (_pContext->_pIn->good())
+  if (_pCur == nullptr || _pCur == _pBegin || _eof)
+    return false;
+  const char* pChar = _pCur - 1;
+  if (_pSkipFrom != nullptr && pChar >= _pSkipFrom)
   {
-    _pContext->prevChar = _pContext->currChar;
-    _pContext->currChar = _pContext->_pIn->get();
-    if (_pContext->currChar == '\n')
-      ++(_pContext->_lineCount);
+    skipInactive();
     return true;
   }
+  if (currChar != '#' || pChar == _pLastDirective)
+    return false;
+  const char* pLineStart = pChar;
+  while (pLineStart > _pBegin && (pLineStart[-1] == ' ' || pLineStart[-1] == '\t'))
+    --pLineStart;
+  if (pLineStart > _pBegin && pLineStart[-1] != '\n')
+    return false;
+  _pLastDirective = pChar;
+  Directive directive = readDirective(pChar, _pEnd);
+  if (!_conditions.apply(directive, *_pConditionals))
+    _pSkipFrom = directive.pNextLine;
   return false;
 }
+//----< move currChar to the directive that ends an inactive region >-
+/*
+ * The skipped text produces no tokens, but comments, literals, and
+ * splices in it are followed, as translation phase 3 does, so only a
+ * real directive line can end the region.  Nested groups are counted,
+ * not evaluated.  Line numbers come from offsets, so they stay exact.
+ */
+void Context::skipInactive()
+{
+  const char* pChar = _pSkipFrom;
+  _pSkipFrom = nullptr;
+  if (pChar < _pCur - 1)                 // a comment ran past the directive's line
+    pChar = std::min(findNewline(_pCur - 1, _pEnd) + 1, _pEnd);
+  size_t nesting = 0;
+  while ((pChar = findSkippedDirective(pChar, _pEnd)) < _pEnd)
+  {
+    Directive directive = readDirective(pChar, _pEnd);
+    const char* pStop;
+    findDirectiveEnd(pChar, _pEnd, pStop);
+    if (directive.opensGroup())
+      ++nesting;
+    else if (nesting > 0 && directive.kind == DirectiveKind::endifCond)
+      --nesting;
+    else if (nesting == 0 && directive.kind != DirectiveKind::other)
+    {
+      if (_conditions.apply(directive, *_pConditionals))
+        break;
+    }
+    pChar = pStop;                       // after any comment the directive opens
+  }
+  _pLastDirective = pChar;
+  collectThrough(pChar);
+}
 
-//----< logs to console if TEST_LOG is defined >---------------------
-
-void testLog(const std::string& msg);  // forward declaration
+//----< lines started by the chars collected so far >--------------
+/*
+ * Buffer input doesn't count newlines as it collects chars.  The first
+ * request for a line indexes the whole buffer in one pass.
+ */
+size_t Context::lineCount()
+{
+  if (!isBuffered())
+    return _lines.newlines() + 1;
+  if (_pCur == nullptr)
+    return 1;
+  return lineOf(_pCur - _pBegin);
+}
+//----< line of the char at offset >---------------------------------
 
-//----< turn on\off returning comments as tokens >-------------------
+size_t Context::lineOf(size_t offset)
+{
+  if (isBuffered() && !_linesBuilt && _pBegin != nullptr)
+  {
+    _lines.build(_pBegin, _pEnd);
+    _linesBuilt = true;
+  }
+  return _lines.lineOf(offset);
+}
+//----< offset of currChar from start of input >--------------------
 
-void ConsumeState::returnComments(bool doReturnComments)
+size_t Context::currOffset()
 {
-  _pContext->_doReturnComments = doReturnComments;
+  size_t collected = isBuffered() ? _pCur - _pBegin : _charCount;
+  return collected > 0 ? collected - 1 : 0;
 }
-//----< is tok one of the special one character tokens? >------------
+//----< record a malformed byte, keeping at most maxDiagnostics >----
 
-bool ConsumeState::isOneCharToken(Token tok)
+void Context::addDiagnostic(size_t offset, const char* message)
+{
+  if (_diagnostics.size() < Toker::maxDiagnostics)
+    _diagnostics.push_back(TokenDiagnostic{ offset, message });
+  ++_diagnosticCount;
+}
+//----< record the comment a comment state just ate >---------------
+/*
+ * The comment ends before currChar, or at the end of input.  Stream
+ * input moves the text to _commentText, and keeps it out of the token
+ * stream unless comments are returned.
+ */
+void Context::recordComment(CommentKind kind)
+{
+  size_t collected = isBuffered() ? _pCur - _pBegin : _charCount;
+  size_t end = (good() && collected > 0) ? collected - 1 : collected;
+  CommentSpan span;
+  span.offset = _tokenOffset;
+  span.size = end - _tokenOffset;
+  span.kind = kind;
+  _comments.push_back(span);
+  if (isBuffered())
+    return;
+  _commentTextPos.push_back(_commentText.size());
+  _commentText += token;
+  if (!_doReturnComments)
+    token.clear();
+  if (_pSource != nullptr)
+    dropOldComments();
+}
+//----< source input: keep recorded comments under their memory share >
+/*
+ * When the spans and text outgrow _maxCommentMemory, the oldest are
+ * dropped until half of it is used, so each byte is moved only a few
+ * times.  The newest comment is always kept.
+ */
+void Context::dropOldComments()
+{
+  const size_t perComment = sizeof(CommentSpan) + sizeof(size_t);
+  size_t memory = _commentText.size() + _comments.size() * perComment;
+  if (memory <= _maxCommentMemory)
+    return;
+  size_t keepFrom = 0;
+  while (keepFrom + 1 < _comments.size() && memory > _maxCommentMemory / 2)
+  {
+    memory -= _commentTextPos[keepFrom + 1] - _commentTextPos[keepFrom] + perComment;
+    ++keepFrom;
+  }
+  size_t textFrom = _commentTextPos[keepFrom];
+  _comments.erase(_comments.begin(), _comments.begin() + keepFrom);
+  _commentTextPos.erase(_commentTextPos.begin(), _commentTextPos.begin() + keepFrom);
+  for (size_t& pos : _commentTextPos)
+    pos -= textFrom;
+  _commentText.erase(0, textFrom);
+}
+//----< does ch continue the identifier being eaten? >---------------
+/*
+ * A UTF-8 DFA: a lead byte sets how many continuation bytes follow
+ * and the range of the first, which excludes overlong forms,
+ * surrogates, and code points above U+10FFFF.  A byte that breaks a
+ * sequence is reported, then judged on its own.  Called with the
+ * identifier's first char too, so a lead byte there is tracked.
+ */
+bool Context::continuesIdent(int ch)
 {
-  for (size_t i = 0; i < _pContext->_oneCharTokens.size(); ++i)
-    if (_pContext->_oneCharTokens[i] == tok)
+  if (_utf8Remaining > 0)
+  {
+    if (ch >= _utf8Lo && ch <= _utf8Hi)
+    {
+      --_utf8Remaining;
+      _utf8Lo = 0x80;
+      _utf8Hi = 0xBF;
       return true;
-  return false;
+    }
+    addDiagnostic(_utf8LeadOffset, "truncated UTF-8 sequence");
+    _utf8Remaining = 0;
+  }
+  if (ch < 0x80)
+    return isIdentChar(ch);
+  if (!isUtf8Lead(ch))
+    return false;
+  _utf8LeadOffset = currOffset();
+  _utf8Lo = 0x80;
+  _utf8Hi = 0xBF;
+  if (ch < 0xE0)
+    _utf8Remaining = 1;
+  else if (ch < 0xF0)
+  {
+    _utf8Remaining = 2;
+    if (ch == 0xE0)
+      _utf8Lo = 0xA0;
+    else if (ch == 0xED)
+      _utf8Hi = 0x9F;
+  }
+  else
+  {
+    _utf8Remaining = 3;
+    if (ch == 0xF0)
+      _utf8Lo = 0x90;
+    else if (ch == 0xF4)
+      _utf8Hi = 0x8F;
+  }
+  return true;
+}
+//----< is currChar the first non-blank char of its line? >---------
+/*
+ * Buffer input looks back from currChar.  Stream input can't, so
+ * collectChar() keeps _lineStart up to date instead.
+ */
+bool Context::atLineStart()
+{
+  if (!isBuffered())
+    return _lineStart;
+  const char* pChar = _pCur - 1;
+  while (pChar > _pBegin && isBlankChar(static_cast<unsigned char>(pChar[-1])))
+    --pChar;
+  return pChar == _pBegin || pChar[-1] == '\n';
+}
+//----< add currChar to the token >---------------------------------
+/*
+ * Buffer input tokens are runs of the source bytes, so the token just
+ * grows to end after currChar.  Stream input appends it to token.
+ */
+void Context::takeChar()
+{
+  if (isBuffered())
+    endToken(_pCur);
+  else
+    token += static_cast<char>(currChar);
+}
+//----< view of current token >--------------------------------------
+/*
+ * Buffer input views refer to the buffer, so no char is copied.
+ * Stream input views refer to token.
+ */
+TokenView Context::tokenView()
+{
+  TokenView view;
+  view.pData = isBuffered() ? _pBegin + _tokenOffset : token.data();
+  view.size = tokenSize();
+  view.offset = _tokenOffset;
+  return view;
 }
-//----< is tok one of the special two character tokens? >------------
+//----< current token as a string, copied from a buffer on demand >-
 
-bool ConsumeState::isTwoCharToken(Token tok)
+const std::string& Context::tokenText()
 {
-  for (size_t i = 0; i < _pContext->_twoCharTokens.size(); ++i)
-    if (_pContext->_twoCharTokens[i] == tok)
-      return true;
-  return false;
+  if (isBuffered())
+    token.assign(_pBegin + _tokenOffset, _tokenSize);
+  return token;
+}
+
+//----< logs to console if TEST_LOG is defined >---------------------
+
+void testLog(const char* msg);  // forward declaration
+
+//----< turn on\off returning comments as tokens >-------------------
+
+void ConsumeState::returnComments(bool doReturnComments)
+{
+  _pContext->_doReturnComments = doReturnComments;
 }
-//----< make a string with this one integer >------------------------
+//----< turn on\off returning each directive as one token >---------
 
-ConsumeState::Token ConsumeState::makeString(int ch)
+void ConsumeState::returnDirectives(bool doReturnDirectives)
 {
-  Token temp;
-  return temp += ch;
+  _pContext->_doReturnDirectives = doReturnDirectives;
 }
 //----< decide which state to use next >-----------------------------
 
 ConsumeState* ConsumeState::nextState()
 {
-  if (!(_pContext->_pIn->good()))
+  if (!good())
   {
     return nullptr;
   }
-  int chNext = _pContext->_pIn->peek();
+  int chNext = peek();
   if (chNext == EOF)
   {
-    _pContext->_pIn->clear();
+    clearEof();
     // if peek() reads end of file character, EOF, then eofbit is set and
     // _pIn->good() will return false.  clear() restores state to good
   }
-  if (isOneCharToken(makeString(_pContext->currChar)))
+  if (_pContext->currChar == '.' && isDigitChar(chNext))
+  {
+    testLog("state: eatNumber");
+    return _pContext->_pEatNumber;
+  }
+  if (isOneCharToken(_pContext->currChar) && !isPunctChar(_pContext->currChar))
   {
     return _pContext->_pEatSpecialCharacters;
   }
-  if (std::isspace(_pContext->currChar) && _pContext->currChar != '\n')
+  if (isBlankChar(_pContext->currChar))
   {
     testLog("state: eatWhitespace");
     return _pContext->_pEatWhitespace;
@@ -283,7 +908,12 @@ ConsumeState* ConsumeState::nextState()
     testLog("state: eatCComment");
     return _pContext->_pEatCComment;
   }
-  if (std::isalnum(_pContext->currChar) || _pContext->currChar == '_')
+  if (isDigitChar(_pContext->currChar))
+  {
+    testLog("state: eatNumber");
+    return _pContext->_pEatNumber;
+  }
+  if (isIdentChar(_pContext->currChar) || isUtf8Lead(_pContext->currChar))
   {
     testLog("state: eatAlphanum");
     return _pContext->_pEatAlphanum;
@@ -296,17 +926,43 @@ ConsumeState* ConsumeState::nextState()
   {
     return _pContext->_pEatSQString;
   }
-  if (ispunct(_pContext->currChar))
+  if (_pContext->currChar == '#' && _pContext->_doReturnDirectives && _pContext->atLineStart())
+  {
+    testLog("state: eatDirective");
+    return _pContext->_pEatDirective;
+  }
+  if (isPunctChar(_pContext->currChar))
   {
     testLog("state: eatPunctuator");
     return _pContext->_pEatPunctuator;
   }
-  if (!_pContext->_pIn->good())
+  if (good() && _pContext->currChar != '\n')   // EatWhitespace steps over the bad byte
   {
-    return _pContext->_pEatWhitespace;
+    _pContext->addDiagnostic(_pContext->currOffset(), invalidCharMessage(_pContext->currChar));
   }
-  std::string error = "invalid type, currChar = " + Utilities::Converter<char>::toString(_pContext->currChar);
-  throw(std::logic_error(error.c_str()));
+  return _pContext->_pEatWhitespace;
+}
+//----< kind of a token collected by EatAlphanum >-------------------
+
+TokenKind wordKind(const TokenView& tok)
+{
+  if (tok.size > 0 && tok[0] >= '0' && tok[0] <= '9')
+    return TokenKind::number;
+  if (std::memchr(tok.pData, '\"', std::min<size_t>(tok.size, 4)) != nullptr)
+    return TokenKind::stringLiteral;   // raw string: prefix, then quote
+  if (isKeywordId(fixedId(tok.pData, tok.size)))
+    return TokenKind::keyword;
+  return TokenKind::identifier;
+}
+//----< kind of a punctuator or special char token >-------------
+
+TokenKind punctuatorKind(const TokenView& tok)
+{
+  if (tok.size == 1 && tok[0] == '\n')
+    return TokenKind::newline;
+  if (tok.size == 1 && tok[0] == '#')
+    return TokenKind::preprocHash;
+  return TokenKind::punctuator;
 }
 //----< class that consumes whitespace >-----------------------------
 
@@ -319,13 +975,58 @@ public:
   }
   virtual void eatChars()
   {
-    _pContext->token.clear();
+    _pContext->clearToken();
+    if (isBuffered() && good())
+    {
+      collectThrough(skipBlanks(_pContext->_pCur, _pContext->_pEnd));
+      return;
+    }
     do {
       if (!collectChar())
         return;
-    } while (std::isspace(_pContext->currChar) && _pContext->currChar != '\n');
+    } while (isBlankChar(_pContext->currChar));
   }
 };
+//----< buffer input: eat C++ comment starting at currChar >---------
+
+void eatCppCommentBuffered(Context* pContext)
+{
+  const char* pStart = pContext->_pCur;
+  const char* pEnd = pContext->_pEnd;
+  const char* pNewline = findNewline(pStart, pEnd);
+  if (pContext->_doReturnComments)
+    pContext->endToken(pNewline);
+  pContext->collectThrough(pNewline);
+}
+//----< buffer input: eat C comment starting at currChar >-----------
+/*
+ * The terminator search starts at the char after the opening '/',
+ * just as the stream loop does, so a slash, star, slash sequence
+ * is a complete comment.
+ */
+void eatCCommentBuffered(Context* pContext)
+{
+  const char* pStart = pContext->_pCur;
+  const char* pEnd = pContext->_pEnd;
+  const char* pStar = findCommentEnd(pStart, pEnd);
+  bool doReturn = pContext->_doReturnComments;
+  if (pStar + 1 < pEnd)            // found terminator
+  {
+    if (doReturn)
+      pContext->endToken(pStar + 2);
+    pContext->collectThrough(pStar + 2);
+    return;
+  }
+  if (doReturn)                    // input ends in the comment
+    pContext->endToken(pEnd);
+  if (pStar + 1 == pEnd)           // input ends with '*', peek() hits end
+  {
+    pContext->collectThrough(pStar);
+    pContext->_eof = true;
+    return;
+  }
+  pContext->collectThrough(pEnd);
+}
 //----< class that consumes C++ comment >----------------------------
 
 class EatCppComment : public ConsumeState
@@ -335,11 +1036,20 @@ public:
   {
     _pContext = pContext;
   }
+  virtual TokenKind tokenKind()
+  {
+    return TokenKind::comment;
+  }
   virtual void eatChars()
   {
-    _pContext->token.clear();
+    _pContext->clearToken();
+    if (isBuffered())
+    {
+      eatCppCommentBuffered(_pContext);
+      return;
+    }
     do {
-      if (_pContext->_doReturnComments)
+      if (_pContext->collectsComments())
         _pContext->token += _pContext->currChar;
       if (!collectChar())
         return;
@@ -355,25 +1065,73 @@ public:
   {
     _pContext = pContext;
   }
+  virtual TokenKind tokenKind()
+  {
+    return TokenKind::comment;
+  }
   virtual void eatChars()
   {
-    _pContext->token.clear();
+    _pContext->clearToken();
+    if (isBuffered())
+    {
+      eatCCommentBuffered(_pContext);
+      return;
+    }
     do {
-      if (_pContext->_doReturnComments)
+      if (_pContext->collectsComments())
         _pContext->token += _pContext->currChar;
       if (!collectChar())
         return;
-    } while (_pContext->currChar != '*' || _pContext->_pIn->peek() != '/');
-    if (_pContext->_doReturnComments)
+    } while (_pContext->currChar != '*' || peek() != '/');
+    if (_pContext->collectsComments())
       _pContext->token += _pContext->currChar;
     if (!collectChar())      // get terminating '/'
       return;
-    if (_pContext->_doReturnComments)
+    if (_pContext->collectsComments())
       _pContext->token += _pContext->currChar;
     collectChar();           // get first non-comment char
   }
 };
-//----< class that eats punctuators >--------------------------------
+//----< eat operator or punctuator starting at currChar >-----------
+/*
+ * Shared by EatPunctuator and TableLexer.  The token is the longest
+ * C++ operator, or special two char token, that starts at currChar,
+ * so "->*", "!=", and "&&" are single tokens and ");" is two.  Any
+ * other punctuator char is a token by itself.  Stream input looks one
+ * char past currChar, with OperatorTrie::takes(), and buffer input
+ * calls munch(), which follows the same rule.
+ */
+void eatPunctuator(Context* pContext)
+{
+  Context& ctx = *pContext;
+  const OperatorTrie& trie = OperatorTrie::cpp();
+  const SpecialTokens& specials = *ctx._pSpecialTokens;
+  int first = ctx.currChar;
+  if (ctx.isBuffered())
+  {
+    const char* pStart = ctx._pCur - 1;
+    const char* pStop = trie.munch(pStart, ctx._pEnd);
+    if (pStop == pStart + 1 && pStop < ctx._pEnd && specials.isTwoCharToken(first, static_cast<unsigned char>(*pStop)))
+      ++pStop;
+    ctx.endToken(pStop);
+    ctx.collectThrough(pStop);
+    return;
+  }
+  OperatorTrie::Node node = trie.first(first);
+  ctx.token += static_cast<char>(first);
+  if (!ctx.collectChar())
+    return;
+  bool isPair = specials.isTwoCharToken(first, ctx.currChar);
+  while (isPair || trie.takes(node, ctx.currChar, ctx.peekInToken()))
+  {
+    isPair = false;
+    node = trie.next(node, ctx.currChar);
+    ctx.token += static_cast<char>(ctx.currChar);
+    if (!ctx.collectChar())
+      return;
+  }
+}
+//----< class that eats operators and other punctuators >-----------
 
 class EatPunctuator : public ConsumeState
 {
@@ -382,110 +1140,316 @@ public:
   {
     _pContext = pContext;
   }
+  virtual TokenKind tokenKind()
+  {
+    return punctuatorKind(_pContext->tokenView());
+  }
   virtual void eatChars()
   {
-    _pContext->token.clear();
-    do {
-      if (_pContext->currChar == '\"' && _pContext->prevChar != '\\')    // start of double quoted string
-      {
-        return;
-      }
-      if (_pContext->currChar == '\'' && _pContext->prevChar != '\\')    // start of single quoted string
-      {
-        return;
-      }
-      Token temp = makeString(_pContext->currChar);
-      if (isOneCharToken(temp))
-      {
-        return;
-      }
-      _pContext->token += _pContext->currChar;
-      if (!_pContext->_pIn->good())  // end of stream
-      {
-        return;
-      }
-      if (!collectChar())
-        return;
-    } while (ispunct(_pContext->currChar));
+    _pContext->clearToken();
+    eatPunctuator(_pContext);
   }
 };
-//----< class that eats alphanumeric characters >--------------------
+//----< eat directive whose '#' is currChar >-----------------------
 /*
- * treats underscore '_' as alphanumeric character
+ * Shared by EatDirective and TableLexer.  Both inputs follow the
+ * directive with a DirectiveScan, so it ends at the same char, and
+ * drop the blanks that end it, which are skipped like whitespace.
  */
-class EatAlphanum : public ConsumeState
+void eatDirective(Context* pContext)
 {
-public:
-  EatAlphanum(Context* pContext)
+  Context& ctx = *pContext;
+  if (ctx.isBuffered())
   {
-    _pContext = pContext;
+    const char* pStop = nullptr;
+    const char* pTextEnd = findDirectiveEnd(ctx._pCur - 1, ctx._pEnd, pStop);
+    ctx.endToken(pTextEnd);
+    ctx.collectThrough(pStop);
+    return;
   }
-  virtual void eatChars()
+  DirectiveScan scan;
+  ctx.token += '#';
+  size_t textSize = 1;
+  while (ctx.collectChar())
   {
-    _pContext->token.clear();
-    do {
-      _pContext->token += _pContext->currChar;
-      if (!collectChar())
-        return;
-    } while (isalnum(_pContext->currChar) || _pContext->currChar == '_');
+    int ch = ctx.currChar;
+    if (!scan.takes(ch, ch == '/' ? ctx.peekInToken() : 0))
+      break;
+    ctx.token += static_cast<char>(ch);
+    if (!isBlankChar(ch))
+      textSize = ctx.token.size();
   }
-};
-//----< class that eats one and two character tokens >---------------
+  ctx.token.resize(textSize);
+}
+//----< class that eats a whole preprocessor directive >------------
 
-class EatSpecialCharacters : public ConsumeState
+class EatDirective : public ConsumeState
 {
 public:
-  EatSpecialCharacters(Context* pContext)
+  EatDirective(Context* pContext)
   {
     _pContext = pContext;
   }
+  virtual TokenKind tokenKind()
+  {
+    return TokenKind::directive;
+  }
   virtual void eatChars()
   {
-    _pContext->token.clear();
-    _pContext->token += _pContext->currChar;
-    Token temp = makeString(_pContext->currChar) += _pContext->_pIn->peek();
-    if (isTwoCharToken(temp))
-    {
-      collectChar();
-      _pContext->token += _pContext->currChar;
-    }
-    collectChar();
+    _pContext->clearToken();
+    eatDirective(_pContext);
   }
 };
-//----< class that eats double quoted string >-----------------------
-
-bool isEscapted(std::string tok)
+//----< eat identifier or number starting at currChar >-------------
+/*
+ * Shared by EatAlphanum and TableLexer.  Buffer input scans ASCII runs
+ * with skipIdent(), and steps through UTF-8 sequences one byte at a
+ * time, as stream input does for every char.
+ */
+void eatIdent(Context* pContext)
 {
-  size_t backSlashCount = 0;
-  for (size_t i = tok.size() - 1; i >= 0; --i)
+  Context& ctx = *pContext;
+  ctx._utf8Remaining = 0;
+  bool more = ctx.continuesIdent(ctx.currChar);
+  while (more)
   {
-    if (tok[i] == '\\')
-      ++backSlashCount;
-    else break;
+    if (ctx.isBuffered() && ctx._utf8Remaining == 0 && ctx.currChar < 0x80)
+    {
+      const char* pStart = ctx._pCur;
+      const char* pChar = skipIdent(pStart, ctx._pEnd);
+      ctx.endToken(pChar);
+      ctx.collectThrough(pChar);
+    }
+    else
+    {
+      ctx.takeChar();
+      if (!ctx.collectChar())
+        break;
+    }
+    more = ctx.continuesIdent(ctx.currChar);
+  }
+  if (ctx._utf8Remaining > 0)
+  {
+    ctx.addDiagnostic(ctx._utf8LeadOffset, "truncated UTF-8 sequence");
+    ctx._utf8Remaining = 0;
   }
-  return (backSlashCount % 2 == 1);
 }
-
-class EatDQString : public ConsumeState
+//----< eat raw string whose prefix is the token, at currChar '"' >--
+/*
+ * Shared by EatAlphanum and TableLexer.  The delimiter is read first.
+ * If it's invalid, the token ends at the offending char.  Stream input
+ * then compares the token's tail with ")delim" at each quote, buffer
+ * input finds the end with findRawLiteralEnd().  Raw strings span
+ * lines, so only the end of input stops one that isn't closed.
+ */
+void eatRawLiteral(Context* pContext)
 {
-public:
-  EatDQString(Context* pContext)
+  Context& ctx = *pContext;
+  if (ctx.isBuffered())
   {
-    _pContext = pContext;
+    const char* pQuote = ctx._pCur - 1;
+    bool complete;
+    const char* pStop = findRawLiteralEnd(pQuote, ctx._pEnd, complete);
+    ctx.endToken(pStop);
+    if (!complete)
+      ctx.addDiagnostic(ctx._tokenOffset, pStop < ctx._pEnd ? "invalid raw string delimiter" : "unterminated raw string literal");
+    ctx.collectThrough(pStop);
+    return;
   }
-  virtual void eatChars()
-  {
-    _pContext->token.clear();
-    do
+  size_t delimPos = ctx.token.size() + 1;
+  do {
+    ctx.token += static_cast<char>(ctx.currChar);
+    if (!ctx.collectChar())
     {
-      _pContext->token += _pContext->currChar;
-      if (!collectChar())
-        return;
-    } while (_pContext->currChar != '\"' || isEscapted(_pContext->token));
-    _pContext->token += _pContext->currChar;
+      ctx.addDiagnostic(ctx._tokenOffset, "unterminated raw string literal");
+      return;
+    }
+  } while (isRawDelimiterChar(ctx.currChar) && ctx.token.size() - delimPos < maxRawDelimiter);
+  if (ctx.currChar != '(')
+  {
+    ctx.addDiagnostic(ctx._tokenOffset, "invalid raw string delimiter");
+    return;
+  }
+  size_t delimSize = ctx.token.size() - delimPos;
+  size_t bodyPos = ctx.token.size() + 1;
+  do {
+    ctx.token += static_cast<char>(ctx.currChar);
+    if (!ctx.collectChar())
+    {
+      ctx.addDiagnostic(ctx._tokenOffset, "unterminated raw string literal");
+      return;
+    }
+  } while (ctx.currChar != '\"' || ctx.token.size() < bodyPos + delimSize + 1
+    || ctx.token[ctx.token.size() - delimSize - 1] != ')'
+    || ctx.token.compare(ctx.token.size() - delimSize, delimSize, ctx.token, delimPos, delimSize) != 0);
+  ctx.token += '\"';
+  ctx.collectChar();
+}
+//----< class that eats alphanumeric characters >--------------------
+/*
+ * treats underscore '_' and UTF-8 sequences as alphanumeric characters.
+ * An identifier that is a raw string prefix, followed by a quote, goes
+ * on to eat the raw string.
+ */
+class EatAlphanum : public ConsumeState
+{
+public:
+  EatAlphanum(Context* pContext)
+  {
+    _pContext = pContext;
+  }
+  virtual TokenKind tokenKind()
+  {
+    return wordKind(_pContext->tokenView());
+  }
+  virtual void eatChars()
+  {
+    _pContext->clearToken();
+    eatIdent(_pContext);
+    if (_pContext->currChar == '\"' && isRawPrefix(_pContext->tokenView().pData, _pContext->tokenSize()))
+      eatRawLiteral(_pContext);
+  }
+};
+//----< eat preprocessing number starting at currChar >-------------
+/*
+ * Shared by EatNumber and TableLexer.  Follows the rule of
+ * skipNumber(), which buffer input uses.  Stream input looks ahead one
+ * char only for a quote, to see whether it's a digit separator.
+ */
+void eatNumber(Context* pContext)
+{
+  Context& ctx = *pContext;
+  if (ctx.isBuffered())
+  {
+    const char* pStart = ctx._pCur - 1;
+    const char* pStop = skipNumber(pStart, ctx._pEnd);
+    ctx.endToken(pStop);
+    ctx.collectThrough(pStop);
+    return;
+  }
+  int prev;
+  bool more;
+  do {
+    prev = ctx.currChar;
+    ctx.token += static_cast<char>(prev);
+    if (!ctx.collectChar())
+      return;
+    int ch = ctx.currChar;
+    more = isIdentChar(ch) || ch == '.'
+      || ((ch == '+' || ch == '-') && (prev == 'e' || prev == 'E' || prev == 'p' || prev == 'P'))
+      || (ch == '\'' && isIdentChar(ctx.peekInToken()));
+  } while (more);
+}
+//----< class that eats numbers >------------------------------------
+/*
+ * 0x1Fu, 1.5e-10f, .5, and 1'000'000 are each one number token
+ */
+class EatNumber : public ConsumeState
+{
+public:
+  EatNumber(Context* pContext)
+  {
+    _pContext = pContext;
+  }
+  virtual TokenKind tokenKind()
+  {
+    return TokenKind::number;
+  }
+  virtual void eatChars()
+  {
+    _pContext->clearToken();
+    eatNumber(_pContext);
+  }
+};
+//----< class that eats one and two character tokens >---------------
+
+class EatSpecialCharacters : public ConsumeState
+{
+public:
+  EatSpecialCharacters(Context* pContext)
+  {
+    _pContext = pContext;
+  }
+  virtual TokenKind tokenKind()
+  {
+    return punctuatorKind(_pContext->tokenView());
+  }
+  virtual void eatChars()
+  {
+    _pContext->clearToken();
+    _pContext->takeChar();
+    if (isTwoCharToken(_pContext->currChar, peek()))
+    {
+      collectChar();
+      _pContext->takeChar();
+    }
     collectChar();
   }
 };
+//----< build quoted literal token starting at currChar >----------
+/*
+ * Escapes are tracked with one flag, so each char is looked at once.
+ * A backslash escapes the next char, or the next "\r\n", so only an
+ * unescaped line end stops a literal that isn't closed.  Then the
+ * literal is the token, a diagnostic marks its start, and currChar is
+ * the line end, the '\n' or the '\r' of "\r\n".  Buffer input finds
+ * the same end with findLiteralEnd().
+ */
+void eatLiteral(Context* pContext, char quote)
+{
+  Context& ctx = *pContext;
+  const char* message = quote == '\"' ? "unterminated string literal" : "unterminated char literal";
+  if (ctx.isBuffered())
+  {
+    const char* pStop = findLiteralEnd(ctx._pCur, ctx._pEnd, quote);
+    if (pStop < ctx._pEnd && *pStop == quote)
+    {
+      ctx.endToken(pStop + 1);
+      ctx.collectThrough(pStop + 1);
+      return;
+    }
+    ctx.endToken(pStop);
+    ctx.addDiagnostic(ctx._tokenOffset, message);
+    ctx.collectThrough(pStop);
+    return;
+  }
+  bool escaped = false;
+  ctx.token += static_cast<char>(ctx.currChar);
+  while (ctx.collectChar())
+  {
+    int ch = ctx.currChar;
+    if (!escaped && ch == quote)
+    {
+      ctx.token += quote;
+      ctx.collectChar();
+      return;
+    }
+    if (!escaped && (ch == '\n' || (ch == '\r' && ctx.peekInToken() == '\n')))
+      break;
+    escaped = (ch == '\\') ? !escaped : (escaped && ch == '\r' && ctx.peekInToken() == '\n');
+    ctx.token += static_cast<char>(ch);
+  }
+  ctx.addDiagnostic(ctx._tokenOffset, message);
+}
+//----< class that eats double quoted string >-----------------------
+
+class EatDQString : public ConsumeState
+{
+public:
+  EatDQString(Context* pContext)
+  {
+    _pContext = pContext;
+  }
+  virtual TokenKind tokenKind()
+  {
+    return TokenKind::stringLiteral;
+  }
+  virtual void eatChars()
+  {
+    _pContext->clearToken();
+    eatLiteral(_pContext, '\"');
+  }
+};
 //----< class that eats single quoted string >-----------------------
 
 class EatSQString : public ConsumeState
@@ -495,24 +1459,363 @@ public:
   {
     _pContext = pContext;
   }
+  virtual TokenKind tokenKind()
+  {
+    return TokenKind::charLiteral;
+  }
   virtual void eatChars()
   {
-    _pContext->token.clear();
-    do
+    _pContext->clearToken();
+    eatLiteral(_pContext, '\'');
+  }
+};
+///////////////////////////////////////////////////////////////////
+// TableLexer - table-driven alternative to the ConsumeState classes
+/*
+ * - token starts are classified with a 257 entry table, indexed by
+ *   currChar + 1 so EOF has an entry of its own, so there are no
+ *   locale dependent ctype calls
+ * - special tokens are looked up in the Context's compiled
+ *   SpecialTokens, shared with the states
+ * - one switch over a State enum replaces the virtual eatChars()
+ *   dispatch over the heap allocated states
+ * - it produces exactly the same tokens, in the same order, as the
+ *   ConsumeState classes, for both stream and buffer input
+ */
+namespace Scanner
+{
+  class TableLexer
+  {
+  public:
+    enum State {
+      eatWhitespace, eatCppComment, eatCComment, eatPunctuator,
+      eatAlphanum, eatNumber, eatSpecialCharacters, eatDQString, eatSQString, eatDirective,
+      noState
+    };
+    TableLexer(Context* pContext);
+    TableLexer(const TableLexer&) = delete;
+    TableLexer& operator=(const TableLexer&) = delete;
+    bool nextTok();
+    void restart() { _state = eatWhitespace; }
+  private:
+    // ordered so that isPunct() is a range test
+    enum CharClass : unsigned char {
+      ccEnd, ccOther, ccUtf8Lead, ccBlank, ccNewline, ccDigit, ccIdent, ccUnderscore,
+      ccPunct, ccSlash, ccDQuote, ccSQuote
+    };
+    static const CharClass* classTable();
+    CharClass charClass(int ch) { return _pClass[ch + 1]; }
+    bool isPunct(int ch) { return charClass(ch) >= ccUnderscore; }
+    bool isOneCharToken(int ch) { return _pContext->_pSpecialTokens->isOneCharToken(ch); }
+    bool isTwoCharToken(int first, int second) { return _pContext->_pSpecialTokens->isTwoCharToken(first, second); }
+    void eatChars();
+    TokenKind tokenKind();
+    State nextState();
+    Context* _pContext;
+    const CharClass* _pClass;
+    State _state;
+  };
+}
+
+//----< char class table, built once with "C" locale semantics >----
+
+const TableLexer::CharClass* TableLexer::classTable()
+{
+  struct Table
+  {
+    CharClass entries[257];
+    Table()
     {
-      _pContext->token += _pContext->currChar;
-      if (!collectChar())
+      entries[0] = ccEnd;
+      for (int ch = 0; ch < 256; ++ch)
+      {
+        CharClass cc = ccOther;
+        if (ch == ' ' || ch == '\t' || ch == '\v' || ch == '\f' || ch == '\r')
+          cc = ccBlank;
+        else if (ch == '\n')
+          cc = ccNewline;
+        else if (ch >= '0' && ch <= '9')
+          cc = ccDigit;
+        else if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z'))
+          cc = ccIdent;
+        else if (ch == '_')
+          cc = ccUnderscore;
+        else if (ch == '/')
+          cc = ccSlash;
+        else if (ch == '\"')
+          cc = ccDQuote;
+        else if (ch == '\'')
+          cc = ccSQuote;
+        else if (ch > ' ' && ch < 127)
+          cc = ccPunct;
+        else if (isUtf8Lead(ch))
+          cc = ccUtf8Lead;
+        entries[ch + 1] = cc;
+      }
+    }
+  };
+  static const Table table;  // function static initialization is thread safe
+  return table.entries;
+}
+//----< construct lexer sharing the states' context >----------------
+
+TableLexer::TableLexer(Context* pContext)
+  : _pContext(pContext), _pClass(classTable()), _state(eatWhitespace) {}
+
+//----< same decision sequence as ConsumeState::nextState() >--------
+
+TableLexer::State TableLexer::nextState()
+{
+  Context& ctx = *_pContext;
+  if (!ctx.good())
+    return noState;
+  int chNext = ctx.peek();
+  if (chNext == EOF)
+    ctx.clearEof();
+  int ch = ctx.currChar;
+  if (ch == '.' && charClass(chNext) == ccDigit)
+    return eatNumber;
+  if (isOneCharToken(ch) && !isPunct(ch))
+    return eatSpecialCharacters;
+  switch (charClass(ch))
+  {
+  case ccBlank:
+    return eatWhitespace;
+  case ccSlash:
+    if (chNext == '/')
+      return eatCppComment;
+    if (chNext == '*')
+      return eatCComment;
+    return eatPunctuator;
+  case ccDigit:
+    return eatNumber;
+  case ccIdent:
+  case ccUnderscore:
+  case ccUtf8Lead:
+    return eatAlphanum;
+  case ccDQuote:
+    return ctx.prevChar != '\\' ? eatDQString : eatPunctuator;
+  case ccSQuote:
+    return ctx.prevChar != '\\' ? eatSQString : eatPunctuator;
+  case ccPunct:
+    if (ch == '#' && ctx._doReturnDirectives && ctx.atLineStart())
+      return eatDirective;
+    return eatPunctuator;
+  default:
+    break;
+  }
+  if (ctx.good() && ch != '\n')   // eatWhitespace steps over the bad byte
+    ctx.addDiagnostic(ctx.currOffset(), invalidCharMessage(ch));
+  return eatWhitespace;
+}
+//----< consume chars for the current state >------------------------
+/*
+ * Each case mirrors the eatChars() of the state class of the same
+ * name.  Buffer input shares the states' run scanners.
+ */
+void TableLexer::eatChars()
+{
+  Context& ctx = *_pContext;
+  ctx.clearToken();
+  switch (_state)
+  {
+  case eatWhitespace:
+    if (ctx.isBuffered() && ctx.good())
+    {
+      ctx.collectThrough(skipBlanks(ctx._pCur, ctx._pEnd));
+      return;
+    }
+    do {
+      if (!ctx.collectChar())
         return;
-    } while (_pContext->currChar != '\'' || isEscapted(_pContext->token));
-    _pContext->token += _pContext->currChar;
-    collectChar();
+    } while (charClass(ctx.currChar) == ccBlank);
+    return;
+
+  case eatCppComment:
+    if (ctx.isBuffered())
+    {
+      eatCppCommentBuffered(_pContext);
+      return;
+    }
+    do {
+      if (ctx.collectsComments())
+        ctx.token += static_cast<char>(ctx.currChar);
+      if (!ctx.collectChar())
+        return;
+    } while (ctx.currChar != '\n');
+    return;
+
+  case eatCComment:
+    if (ctx.isBuffered())
+    {
+      eatCCommentBuffered(_pContext);
+      return;
+    }
+    do {
+      if (ctx.collectsComments())
+        ctx.token += static_cast<char>(ctx.currChar);
+      if (!ctx.collectChar())
+        return;
+    } while (ctx.currChar != '*' || ctx.peek() != '/');
+    if (ctx.collectsComments())
+      ctx.token += static_cast<char>(ctx.currChar);
+    if (!ctx.collectChar())
+      return;
+    if (ctx.collectsComments())
+      ctx.token += static_cast<char>(ctx.currChar);
+    ctx.collectChar();
+    return;
+
+  case eatPunctuator:
+    ::eatPunctuator(_pContext);
+    return;
+
+  case eatAlphanum:
+    eatIdent(_pContext);
+    if (ctx.currChar == '\"' && isRawPrefix(ctx.tokenView().pData, ctx.tokenSize()))
+      eatRawLiteral(_pContext);
+    return;
+
+  case eatNumber:
+    ::eatNumber(_pContext);
+    return;
+
+  case eatSpecialCharacters:
+    ctx.takeChar();
+    if (isTwoCharToken(ctx.currChar, ctx.peek()))
+    {
+      ctx.collectChar();
+      ctx.takeChar();
+    }
+    ctx.collectChar();
+    return;
+
+  case eatDQString:
+  case eatSQString:
+    eatLiteral(_pContext, (_state == eatDQString) ? '\"' : '\'');
+    return;
+
+  case eatDirective:
+    ::eatDirective(_pContext);
+    return;
+
+  case noState:
+    return;
   }
-};
+}
+//----< kind of the token the current state collected >-------------
+
+TokenKind TableLexer::tokenKind()
+{
+  switch (_state)
+  {
+  case eatCppComment:
+  case eatCComment:
+    return TokenKind::comment;
+  case eatAlphanum:
+    return wordKind(_pContext->tokenView());
+  case eatNumber:
+    return TokenKind::number;
+  case eatPunctuator:
+  case eatSpecialCharacters:
+    return punctuatorKind(_pContext->tokenView());
+  case eatDQString:
+    return TokenKind::stringLiteral;
+  case eatSQString:
+    return TokenKind::charLiteral;
+  case eatDirective:
+    return TokenKind::directive;
+  default:
+    return TokenKind::none;
+  }
+}
+//----< collect next token in Context, same loop as Toker::nextTok() >
+
+bool TableLexer::nextTok()
+{
+  while (true)
+  {
+    if (!_pContext->good())
+      return false;
+    if (_pContext->_checkpointInterval > 0)
+      _pContext->checkpoint();
+    if (_pContext->_pConditionals != nullptr && _pContext->isBuffered() && _pContext->checkConditionals())
+    {
+      _state = nextState();
+      continue;
+    }
+    _pContext->_tokenOffset = _pContext->currOffset();
+    eatChars();
+    if ((_state == eatCppComment || _state == eatCComment) && _pContext->_doRecordComments)
+      _pContext->recordComment(_state == eatCComment ? CommentKind::cComment : CommentKind::cppComment);
+    if (_pContext->tokenSize() > 0)
+      _pContext->_tokenKind = tokenKind();
+    _state = nextState();
+    if (_pContext->tokenSize() > 0)
+      return true;
+  }
+}
+//----< buffer input: record a checkpoint if interval has passed >---
+/*
+ * Called before each state runs.  The next token starts at currChar,
+ * or, before the first, at the start of the buffer.  Places where
+ * restarting there wouldn't give the same tokens are passed over: in
+ * a UTF-8 sequence, before a pending skip, or at a directive already
+ * applied.
+ */
+void Context::checkpoint()
+{
+  if (!isBuffered() || _pCur == nullptr)
+    return;
+  size_t offset = _pCur == _pBegin ? 0 : _pCur - 1 - _pBegin;
+  if (!_checkpoints.empty() && offset < _checkpoints.back().offset + _checkpointInterval)
+    return;
+  if (_utf8Remaining != 0 || _pSkipFrom != nullptr || (_pCur > _pBegin && _pCur - 1 == _pLastDirective))
+    return;
+  TokenCheckpoint checkpoint;
+  checkpoint.offset = offset;
+  checkpoint.line = lineOf(offset);
+  _conditions.save(checkpoint.conditions);
+  _checkpoints.push_back(std::move(checkpoint));
+}
+//----< buffer input: lex again from checkpoint >-------------------
+/*
+ * Starts as attach() does, with whitespace eaten from the checkpoint,
+ * so the states see the same chars a full pass saw.  Comments and
+ * diagnostics at or after the checkpoint are dropped, the rest kept,
+ * so lexing on to the end leaves what a full pass would.
+ */
+bool Context::restore(const TokenCheckpoint& checkpoint)
+{
+  if (!isBuffered() || _pBegin == nullptr || checkpoint.offset > static_cast<size_t>(_pEnd - _pBegin))
+    return false;
+  _pState = _pEatWhitespace;
+  _pTableLexer->restart();
+  clearToken();
+  _tokenOffset = checkpoint.offset;
+  _tokenKind = TokenKind::none;
+  _eof = false;
+  _pCur = _pBegin + checkpoint.offset;
+  currChar = _pCur > _pBegin ? static_cast<unsigned char>(_pCur[-1]) : 0;
+  prevChar = _pCur > _pBegin + 1 ? static_cast<unsigned char>(_pCur[-2]) : 0;
+  _utf8Remaining = 0;
+  auto isAfter = [&checkpoint](size_t offset) { return offset >= checkpoint.offset; };
+  while (_diagnostics.size() > 0 && isAfter(_diagnostics.back().offset))
+    _diagnostics.pop_back();
+  _diagnosticCount = _diagnostics.size();
+  while (_comments.size() > 0 && isAfter(_comments.back().offset))
+    _comments.pop_back();
+  _conditions.restore(checkpoint.conditions);
+  _pLastDirective = nullptr;
+  _pSkipFrom = nullptr;
+  return true;
+}
 //----< construct shared data storage >------------------------------
 
 Context::Context()
 {
   _pEatAlphanum = new EatAlphanum(this);
+  _pEatNumber = new EatNumber(this);
   _pEatCComment = new EatCComment(this);
   _pEatCppComment = new EatCppComment(this);
   _pEatPunctuator = new EatPunctuator(this);
@@ -520,15 +1823,77 @@ Context::Context()
   _pEatSpecialCharacters = new EatSpecialCharacters(this);
   _pEatDQString = new EatDQString(this);
   _pEatSQString = new EatSQString(this);
+  _pEatDirective = new EatDirective(this);
+  _pTableLexer = new TableLexer(this);
+  _pSpecialTokens = SpecialTokens::defaults();
+  _useTableEngine = false;
   _pState = _pEatWhitespace;
-  _lineCount = 1;
+  _pIn = nullptr;
+  _pSource = nullptr;
+  _maxTokenSize = 0;
+  _maxCommentMemory = 0;
+  _elidedOffset = static_cast<size_t>(-1);
+  _charCount = 0;
+  _tokenSize = 0;
+  _tokenOffset = 0;
+  _tokenKind = TokenKind::none;
+  _pBegin = nullptr;
+  _pCur = nullptr;
+  _pEnd = nullptr;
+  _eof = false;
+  prevChar = 0;
+  currChar = 0;
+  _utf8Remaining = 0;
+  _utf8Lo = 0x80;
+  _utf8Hi = 0xBF;
+  _utf8LeadOffset = 0;
+  _diagnosticCount = 0;
+  _linesBuilt = false;
+  _checkpointInterval = 0;
   _doReturnComments = false;
+  _doRecordComments = false;
+  _doReturnDirectives = false;
+  _lineStart = true;
+  _pLastDirective = nullptr;
+  _pSkipFrom = nullptr;
+}
+//----< start over at the beginning of a new input >----------------
+/*
+ * Keeps the states, the token's capacity, and the line index's, so
+ * a Toker reattached to file after file allocates nothing here.
+ */
+void Context::restart()
+{
+  _pState = _pEatWhitespace;
+  _pTableLexer->restart();
+  clearToken();
+  _tokenOffset = 0;
+  _tokenKind = TokenKind::none;
+  _charCount = 0;
+  _elidedOffset = static_cast<size_t>(-1);
+  _eof = false;
+  prevChar = 0;
+  currChar = 0;
+  _lineStart = true;
+  _utf8Remaining = 0;
+  _diagnostics.clear();
+  _diagnosticCount = 0;
+  _comments.clear();
+  _commentText.clear();
+  _commentTextPos.clear();
+  _lines.clear();
+  _linesBuilt = false;
+  _conditions.clear();
+  _pLastDirective = nullptr;
+  _pSkipFrom = nullptr;
+  _checkpoints.clear();
 }
 //----< return shared resources >------------------------------------
 
 Context::~Context()
 {
   delete _pEatAlphanum;
+  delete _pEatNumber;
   delete _pEatCComment;
   delete _pEatCppComment;
   delete _pEatPunctuator;
@@ -536,6 +1901,8 @@ Context::~Context()
   delete _pEatSpecialCharacters;
   delete _pEatDQString;
   delete _pEatSQString;
+  delete _pEatDirective;
+  delete _pTableLexer;
 }
 //----< no longer has anything to do - will be removed >-------------
 
@@ -545,6 +1912,12 @@ ConsumeState::ConsumeState() {}
 
 ConsumeState::~ConsumeState() {}
 
+//----< definitions for the constants, which clients may bind to a reference >
+
+const size_t Toker::defaultMemoryLimit;
+const size_t Toker::maxDiagnostics;
+const size_t Toker::defaultCheckpointInterval;
+
 //----< construct toker starting in state EatWhitespace >------------
 
 Toker::Toker()
@@ -579,20 +1952,154 @@ bool Toker::attach(std::istream* pIn)
   }
   return false;
 }
-//----< collect token generated by ConsumeState >--------------------
+//----< attach tokenizer to caller-owned buffer [pBegin, pEnd) >-----
+/*
+ * - buffer must outlive the attachment
+ * - produces exactly the same tokens and line counts as attaching
+ *   a stream holding the same bytes
+ */
+bool Toker::attach(const char* pBegin, const char* pEnd)
+{
+  if (pBegin != nullptr && pBegin <= pEnd)
+  {
+    pConsumer->attach(pBegin, pEnd);
+    return true;
+  }
+  return false;
+}
+//----< attach tokenizer to a source, using at most memoryLimit >---
+/*
+ * - a quarter of memoryLimit each is the read window, the longest
+ *   token, the line index, and the comments recordComments() keeps
+ * - tokens longer than that are returned with their middle dropped,
+ *   and reported by diagnostics()
+ * - lines stay exact, but lineOf() only knows the lines of recent
+ *   offsets, and comments() holds only recent comments
+ */
+bool Toker::attach(IByteSource* pSource, size_t memoryLimit)
+{
+  if (pSource == nullptr || memoryLimit < 64)
+    return false;
+  size_t share = memoryLimit / 4;
+  pConsumer->attach(pSource, share, share, share / sizeof(size_t), share);
+  return true;
+}
+//----< attach tokenizer to memory-mapped file >---------------------
 
-std::string Toker::getTok()
+bool Toker::attach(const MappedFile& file)
+{
+  if (!file.isOpen())
+    return false;
+  return attach(file.begin(), file.end());
+}
+//----< collect next token into Context, false at end of input >-----
+
+bool Toker::nextTok()
 {
+  if (_pContext->_useTableEngine)
+    return _pContext->_pTableLexer->nextTok();
   while(true) 
   {
     if (!pConsumer->canRead())
-      return "";
+      return false;
+    if (_pContext->_checkpointInterval > 0)
+      _pContext->checkpoint();
+    if (_pContext->_pConditionals != nullptr && _pContext->isBuffered() && _pContext->checkConditionals())
+    {
+      _pContext->_pState = pConsumer->nextState();
+      continue;
+    }
     pConsumer->consumeChars();
     if (pConsumer->hasTok())
-      break;
+      return true;
   }
+}
+//----< collect token generated by ConsumeState >--------------------
+
+std::string Toker::getTok()
+{
+  if (!nextTok())
+    return "";
   return pConsumer->getTok();
 }
+//----< collect token with the kind its state assigned >-------------
+/*
+ * record text is a view, valid as described for getTokView()
+ */
+TokenRecord Toker::getTokRecord()
+{
+  TokenRecord record;
+  if (!nextTok())
+    return record;
+  record.text = _pContext->tokenView();
+  record.kind = _pContext->_tokenKind;
+  return record;
+}
+//----< collect up to max tokens, returns number collected >--------
+/*
+ * - replaces the contents of buffer
+ * - returns 0 at end of input
+ */
+size_t Toker::getToks(TokenBuffer& buffer, size_t max)
+{
+  buffer.clear();
+  buffer._entries.reserve(max);
+  Context& context = *_pContext;
+  bool isBuffered = context.isBuffered();
+  while (buffer._entries.size() < max && nextTok())
+  {
+    TokenBuffer::Entry entry;
+    entry.size = context.tokenSize();
+    entry.offset = context._tokenOffset;
+    entry.kind = context._tokenKind;
+    if (isBuffered)
+    {
+      entry.pData = context._pBegin + context._tokenOffset;
+      entry.textPos = 0;
+    }
+    else
+    {
+      entry.pData = nullptr;
+      entry.textPos = buffer._text.size();
+      buffer._text += context.token;
+    }
+    buffer._entries.push_back(entry);
+  }
+  return buffer._entries.size();
+}
+//----< append count tokens of from, starting at its first >--------
+/*
+ * Tokens that refer to the input still do.  Tokens whose text from
+ * holds are copied into this buffer's text.
+ */
+void TokenBuffer::append(const TokenBuffer& from, size_t first, size_t count)
+{
+  size_t last = std::min(first + count, from._entries.size());
+  for (size_t i = first; i < last; ++i)
+  {
+    Entry entry = from._entries[i];
+    if (entry.pData == nullptr)
+    {
+      entry.textPos = _text.size();
+      _text.append(from._text, from._entries[i].textPos, entry.size);
+    }
+    _entries.push_back(entry);
+  }
+}
+//----< collect token without copying it >---------------------------
+/*
+ * - buffer input: view refers to the attached buffer and stays valid
+ *   as long as the buffer does
+ * - stream input: view refers to Toker's own copy and is valid only
+ *   until the next call
+ * - returns an empty view at end of input
+ */
+TokenView Toker::getTokView()
+{
+  if (!nextTok())
+    return TokenView();
+  return _pContext->tokenView();
+}
 //----< has toker reached the end of its stream? >-------------------
 
 bool Toker::canRead() { return pConsumer->canRead(); }
@@ -603,13 +2110,17 @@ void Toker::returnComments(bool doReturnComments)
 {
   pConsumer->returnComments(doReturnComments);
 }
+//----< start/stop returning each directive as one token >---------
+
+void Toker::returnDirectives(bool doReturnDirectives)
+{
+  pConsumer->returnDirectives(doReturnDirectives);
+}
 //----< is this token a comment? >-----------------------------------
 
 bool Toker::isComment(const std::string& tok)
 {
-  if (tok.find("//") < tok.size() || tok.find("/*") < tok.size())
-    return true;
-  return false;
+  return tok.compare(0, 2, "//") == 0 || tok.compare(0, 2, "/*") == 0;
 }
 //----< return number of newlines pulled from stream >---------------
 
@@ -617,15 +2128,235 @@ size_t Toker::currentLineCount()
 {
   return pConsumer->currentLineCount();
 }
+//----< line of the char at offset, e.g., a token's offset >--------
+/*
+ * - buffer input: any offset in the buffer
+ * - stream input: any offset already collected, which includes the
+ *   offsets of all tokens returned so far
+ */
+size_t Toker::lineOf(size_t offset)
+{
+  return _pContext->lineOf(offset);
+}
 //----< set one and two char tokens >--------------------------------
 
 void Toker::setSpecialTokens(const std::string& commaSeparatedTokens)
 {
   pConsumer->setSpecialTokens(commaSeparatedTokens);
 }
+//----< share a compiled set of one and two char tokens >------------
+/*
+ * The set is immutable, so Tokers on other threads may share it.
+ */
+void Toker::setSpecialTokens(SpecialTokens::Ptr pSpecialTokens)
+{
+  pConsumer->setSpecialTokens(pSpecialTokens);
+}
+//----< compiled set in use >----------------------------------------
+
+SpecialTokens::Ptr Toker::specialTokens()
+{
+  return _pContext->_pSpecialTokens;
+}
+//----< switch between the states and the table-driven engine >-----
+/*
+ * Both engines produce the same tokens.  Select the engine before
+ * the first getTok(), each engine tracks its own current state.
+ */
+void Toker::useTableEngine(bool doUseTableEngine)
+{
+  _pContext->_useTableEngine = doUseTableEngine;
+}
+//----< skip regions the known macros make inactive, null for none >-
+/*
+ * - applies to buffer input, from the next attach()
+ * - stream and source input still tokenize every region
+ */
+void Toker::setConditionals(std::shared_ptr<const Conditionals> pConditionals)
+{
+  _pContext->_pConditionals = pConditionals;
+}
+//----< record a span for every comment, returned or not >---------
+/*
+ * Applies from the next token.  Spans are cleared by attach().
+ */
+void Toker::recordComments(bool doRecordComments)
+{
+  _pContext->_doRecordComments = doRecordComments;
+}
+//----< comments recorded since attach(), in input order >----------
+/*
+ * IByteSource input keeps only the most recent, within memoryLimit.
+ */
+
+const std::vector<CommentSpan>& Toker::comments()
+{
+  return _pContext->_comments;
+}
+//----< text of a recorded comment >---------------------------------
+/*
+ * - buffer input: copied from the buffer, which must still exist
+ * - stream input: the copy kept when the span was recorded
+ */
+std::string Toker::commentText(const CommentSpan& span)
+{
+  Context& ctx = *_pContext;
+  if (ctx.isBuffered())
+  {
+    if (ctx._pBegin == nullptr || span.offset + span.size > static_cast<size_t>(ctx._pEnd - ctx._pBegin))
+      return "";
+    return std::string(ctx._pBegin + span.offset, span.size);
+  }
+  auto iter = std::lower_bound(ctx._comments.begin(), ctx._comments.end(), span.offset,
+    [](const CommentSpan& recorded, size_t offset) { return recorded.offset < offset; });
+  if (iter == ctx._comments.end() || iter->offset != span.offset)
+    return "";
+  size_t index = iter - ctx._comments.begin();
+  size_t pos = ctx._commentTextPos[index];
+  size_t end = index + 1 < ctx._commentTextPos.size() ? ctx._commentTextPos[index + 1] : ctx._commentText.size();
+  return ctx._commentText.substr(pos, end - pos);
+}
+//----< forget the comments recorded so far >-----------------------
+
+void Toker::clearComments()
+{
+  _pContext->_comments.clear();
+  _pContext->_commentText.clear();
+  _pContext->_commentTextPos.clear();
+}
+//----< malformed bytes stepped over since attach(), oldest first >-
+/*
+ * Holds at most maxDiagnostics entries, diagnosticCount() counts all.
+ */
+const std::vector<TokenDiagnostic>& Toker::diagnostics()
+{
+  return _pContext->_diagnostics;
+}
+//----< number of malformed bytes found since attach() >-------------
+
+size_t Toker::diagnosticCount()
+{
+  return _pContext->_diagnosticCount;
+}
+//----< forget the diagnostics collected so far >--------------------
+
+void Toker::clearDiagnostics()
+{
+  _pContext->_diagnostics.clear();
+  _pContext->_diagnosticCount = 0;
+}
+//----< buffer input: keep a checkpoint every interval bytes >------
+/*
+ * 0 stops recording.  The checkpoints already recorded are kept until
+ * the next attach().
+ */
+void Toker::recordCheckpoints(size_t interval)
+{
+  _pContext->_checkpointInterval = interval;
+}
+//----< checkpoints recorded since attach(), in offset order >-------
+
+const std::vector<TokenCheckpoint>& Toker::checkpoints()
+{
+  return _pContext->_checkpoints;
+}
+//----< last checkpoint at or before offset, null if there is none >-
+
+const TokenCheckpoint* Toker::findCheckpoint(size_t offset)
+{
+  std::vector<TokenCheckpoint>& checkpoints = _pContext->_checkpoints;
+  auto iter = std::upper_bound(checkpoints.begin(), checkpoints.end(), offset,
+    [](size_t value, const TokenCheckpoint& checkpoint) { return value < checkpoint.offset; });
+  return iter == checkpoints.begin() ? nullptr : &*(iter - 1);
+}
+//----< lex again from checkpoint, false unless buffer input >-------
+/*
+ * The next token is the first a full pass returned at or after
+ * checkpoint.offset.  checkpoint must come from this attachment.
+ */
+bool Toker::restore(const TokenCheckpoint& checkpoint)
+{
+  return _pContext->restore(checkpoint);
+}
+//----< lex again from the last checkpoint at or before offset >-----
+/*
+ * Tokens before offset, back to the checkpoint, are returned again,
+ * so a client skips those it doesn't need.
+ */
+bool Toker::seekOffset(size_t offset)
+{
+  const TokenCheckpoint* pCheckpoint = findCheckpoint(offset);
+  return pCheckpoint != nullptr && restore(*pCheckpoint);
+}
+//----< lex again from the last checkpoint at or before line >-------
+
+bool Toker::seekLine(size_t line)
+{
+  if (!_pContext->isBuffered() || _pContext->_pBegin == nullptr)
+    return false;
+  _pContext->lineOf(0);
+  return seekOffset(_pContext->_lines.lineStart(line));
+}
+//----< classify a token that didn't come from a Toker >------------
+/*
+ * For tokens built by clients, e.g., SemiExp::push_back(tok).  Toker
+ * doesn't use it, each of its states knows what kind it collects.
+ */
+TokenKind Scanner::classifyToken(const std::string& tok)
+{
+  if (tok.size() == 0)
+    return TokenKind::none;
+  if (tok.compare(0, 2, "//") == 0 || tok.compare(0, 2, "/*") == 0)
+    return TokenKind::comment;
+  if (tok[0] == '\"')
+    return TokenKind::stringLiteral;
+  if (tok[0] == '\'')
+    return TokenKind::charLiteral;
+  if (tok[0] == '#' && tok.size() > 1 && tok != "##")
+    return TokenKind::directive;
+  unsigned char first = static_cast<unsigned char>(tok[0]);
+  TokenView view;
+  view.pData = tok.data();
+  view.size = tok.size();
+  if (isIdentChar(first) || isUtf8Lead(first))
+    return wordKind(view);
+  if (first == '.' && tok.size() > 1 && isDigitChar(static_cast<unsigned char>(tok[1])))
+    return TokenKind::number;
+  return punctuatorKind(view);
+}
+//----< display name of kind >---------------------------------------
+
+const char* Scanner::kindName(TokenKind kind)
+{
+  switch (kind)
+  {
+  case TokenKind::identifier:
+    return "identifier";
+  case TokenKind::keyword:
+    return "keyword";
+  case TokenKind::number:
+    return "number";
+  case TokenKind::punctuator:
+    return "punctuator";
+  case TokenKind::stringLiteral:
+    return "string";
+  case TokenKind::charLiteral:
+    return "char";
+  case TokenKind::comment:
+    return "comment";
+  case TokenKind::newline:
+    return "newline";
+  case TokenKind::preprocHash:
+    return "preproc hash";
+  case TokenKind::directive:
+    return "directive";
+  default:
+    return "none";
+  }
+}
 //----< debugging output to console if TEST_LOG is #defined >--------
 
-void testLog(const std::string& msg)
+void testLog(const char* msg)
 {
 #ifdef TEST_LOG
   std::cout << "\n  " << msg;
@@ -641,6 +2372,8 @@ using namespace Utilities;
 
 #include <fstream>
 #include <exception>
+#include <iomanip>
+#include <sstream>
 
 
 int main()
@@ -695,6 +2428,243 @@ int main()
       std::cout << "\n -- " << tok;
     } while (in.good());
     std::cout << "\n  current line count = " << toker.currentLineCount();
+
+    putline();
+    Helper::title("Testing memory-mapped input");
+    MappedFile file(fileSpec);
+    if (!file.isOpen())
+    {
+      std::cout << "\n  can't map " << fileSpec << "\n\n";
+      return 1;
+    }
+    Toker streamToker;
+    in.clear();
+    in.seekg(std::ios::beg);
+    streamToker.attach(&in);
+    Toker mappedToker;
+    mappedToker.attach(file);
+    size_t numToks = 0;
+    bool same = true;
+    while (streamToker.canRead() || mappedToker.canRead())
+    {
+      if (streamToker.getTok() != mappedToker.getTok())
+        same = false;
+      ++numToks;
+    }
+    same = same && streamToker.currentLineCount() == mappedToker.currentLineCount();
+    std::cout << "\n  " << numToks << " tokens, mapped input matches stream input: "
+      << std::boolalpha << same;
+
+    putline();
+    Helper::title("Testing table driven engine");
+    Toker stateToker;
+    stateToker.returnComments();
+    stateToker.attach(file);
+    Toker tableToker;
+    tableToker.returnComments();
+    tableToker.useTableEngine();
+    tableToker.attach(file);
+    numToks = 0;
+    same = true;
+    while (stateToker.canRead() || tableToker.canRead())
+    {
+      if (stateToker.getTok() != tableToker.getTok())
+        same = false;
+      ++numToks;
+    }
+    same = same && stateToker.currentLineCount() == tableToker.currentLineCount();
+    std::cout << "\n  " << numToks << " tokens, table engine matches states: "
+      << std::boolalpha << same;
+
+    putline();
+    Helper::title("Testing token views");
+    Toker viewToker;
+    viewToker.attach(file);
+    for (size_t i = 0; i < 8; ++i)
+    {
+      TokenView view = viewToker.getTokView();
+      if (view.empty())
+        break;
+      std::cout << "\n -- offset " << view.offset << ": " << (view == "\n" ? "newline" : view.str());
+    }
+
+    putline();
+    Helper::title("Testing batched tokens");
+    Toker batchToker;
+    batchToker.returnComments();
+    batchToker.attach(file);
+    TokenBuffer batch;
+    size_t numBatches = 0;
+    numToks = 0;
+    while (batchToker.getToks(batch, 100) > 0)
+    {
+      ++numBatches;
+      numToks += batch.size();
+    }
+    std::cout << "\n  " << numToks << " tokens in " << numBatches << " batches of up to 100";
+
+    putline();
+    Helper::title("Testing bounded memory source input");
+    Toker sourceToker;
+    FileByteSource source(fileSpec);
+    sourceToker.attach(&source, 1024);
+    Toker bufferToker;
+    bufferToker.attach(file);
+    same = true;
+    numToks = 0;
+    while (true)
+    {
+      std::string tok = bufferToker.getTok();
+      if (tok != sourceToker.getTok())
+        same = false;
+      if (tok.empty())
+        break;
+      ++numToks;
+    }
+    same = same && bufferToker.currentLineCount() == sourceToker.currentLineCount();
+    std::cout << "\n  " << numToks << " tokens through a 1024 byte limit match buffer input: " << same;
+    std::istringstream longStream("int a; char* s = \"" + std::string(100000, 'x') + "\"; int b;");
+    StreamByteSource longSource(longStream);
+    Toker longToker;
+    longToker.attach(&longSource, 1024);
+    std::cout << "\n  a 100000 char literal through the same limit:";
+    for (TokenView view = longToker.getTokView(); !view.empty(); view = longToker.getTokView())
+      std::cout << " " << (view.size > 20 ? std::to_string(view.size) + " chars" : view.str());
+    for (auto diagnostic : longToker.diagnostics())
+      std::cout << "\n -- offset " << diagnostic.offset << ": " << diagnostic.message;
+
+    putline();
+    Helper::title("Testing inactive region skipping");
+    std::string conditional =
+      "#if defined(_WIN32) && !defined(__linux__)\nwindows();\n"
+      "#else\nposix();\n#endif\n#if 0\nnever();\n#endif\n"
+      "#if 0\n/* disabled:\n#endif\n*/\nhidden(\"#endif\");\n#endif\ndone();\n";
+    Toker condToker;
+    condToker.setConditionals(Conditionals::compile("_WIN32, !__linux__"));
+    condToker.attach(conditional.data(), conditional.data() + conditional.size());
+    for (TokenRecord record = condToker.getTokRecord(); !record.empty(); record = condToker.getTokRecord())
+    {
+      if (record.kind != TokenKind::newline)
+        std::cout << "\n -- line " << condToker.lineOf(record.offset()) << ": " << record.text.str();
+    }
+
+    putline();
+    Helper::title("Testing malformed bytes");
+    std::string malformed = "int caf\xC3\xA9 = 1;\x01 x\xFFy \xE2\x82";
+    Toker utf8Toker;
+    utf8Toker.attach(malformed.data(), malformed.data() + malformed.size());
+    for (TokenView view = utf8Toker.getTokView(); !view.empty(); view = utf8Toker.getTokView())
+      std::cout << "\n -- " << view.str();
+    for (auto diagnostic : utf8Toker.diagnostics())
+      std::cout << "\n -- offset " << diagnostic.offset << ": " << diagnostic.message;
+
+    putline();
+    Helper::title("Testing unterminated literals");
+    std::string literals = "int n = 1'000'000;\nchar* s = \"runs on\nx = 'a';";
+    Toker literalToker;
+    literalToker.attach(literals.data(), literals.data() + literals.size());
+    for (TokenRecord record = literalToker.getTokRecord(); !record.empty(); record = literalToker.getTokRecord())
+    {
+      if (record.kind != TokenKind::newline)
+        std::cout << "\n -- " << kindName(record.kind) << ": " << record.text.str();
+    }
+    for (auto diagnostic : literalToker.diagnostics())
+      std::cout << "\n -- line " << literalToker.lineOf(diagnostic.offset) << ": " << diagnostic.message;
+
+    putline();
+    Helper::title("Testing numbers and raw strings");
+    std::string numbers = "x = 1.5e-10f + 0x1Fu * .5 - 1'000'000;\nauto s = R\"sql(select \"a\"\n)\" from)sql\";";
+    Toker numberToker;
+    numberToker.attach(numbers.data(), numbers.data() + numbers.size());
+    for (TokenRecord record = numberToker.getTokRecord(); !record.empty(); record = numberToker.getTokRecord())
+    {
+      if (record.kind == TokenKind::number || record.kind == TokenKind::stringLiteral)
+        std::cout << "\n -- " << kindName(record.kind) << ": " << record.text.str();
+    }
+
+    putline();
+    Helper::title("Testing operators");
+    std::string operators = "p->*q <<= a...b; if (x!=y&&(z)) c.*d; x>>=1;;";
+    std::istringstream operatorStream(operators);
+    Toker operatorToker;
+    operatorToker.attach(&operatorStream);
+    std::cout << "\n -- ";
+    for (TokenRecord record = operatorToker.getTokRecord(); !record.empty(); record = operatorToker.getTokRecord())
+    {
+      if (record.kind == TokenKind::punctuator)
+        std::cout << record.text.str() << "  ";
+    }
+
+    putline();
+    Helper::title("Testing directive records");
+    std::string directives = "#include <vector>  // vector\n  # define MAX(a, b) \\\n    ((a) > (b) ? (a) : (b))\nint n = MAX(1, 2); # not one\n";
+    Toker directiveToker;
+    directiveToker.returnDirectives();
+    directiveToker.attach(directives.data(), directives.data() + directives.size());
+    for (TokenRecord record = directiveToker.getTokRecord(); !record.empty(); record = directiveToker.getTokRecord())
+    {
+      if (record.kind == TokenKind::directive)
+      {
+        Directive directive = readDirectiveToken(record.text.begin(), record.text.end());
+        std::cout << "\n -- line " << directiveToker.lineOf(record.offset()) << ": "
+          << std::string(directive.pExpression, directive.pExpressionEnd);
+      }
+    }
+
+    putline();
+    Helper::title("Testing comment spans");
+    Toker spanToker;
+    spanToker.recordComments();
+    spanToker.attach(file);
+    size_t spanTokens = 0;
+    while (spanToker.getTokView().size > 0)
+      ++spanTokens;
+    std::cout << "\n -- " << spanTokens << " tokens, " << spanToker.comments().size() << " comments";
+    for (size_t i = 0; i < spanToker.comments().size() && i < 3; ++i)
+    {
+      CommentSpan span = spanToker.comments()[i];
+      std::cout << "\n -- line " << spanToker.lineOf(span.offset) << ", " << span.size << " chars: "
+        << spanToker.commentText(span).substr(0, 40);
+    }
+
+    putline();
+    Helper::title("Testing token records");
+    Toker recordToker;
+    recordToker.returnComments();
+    recordToker.attach(file);
+    for (size_t i = 0; i < 12; ++i)
+    {
+      TokenRecord record = recordToker.getTokRecord();
+      if (record.empty())
+        break;
+      std::cout << "\n -- " << std::setw(12) << kindName(record.kind) << ": "
+        << (record.kind == TokenKind::newline ? "newline" : record.text.str());
+    }
+
+    putline();
+    Helper::title("Testing checkpoints");
+    for (bool useTable : { false, true })
+    {
+      Toker checkToker;
+      checkToker.useTableEngine(useTable);
+      checkToker.recordCheckpoints(64);
+      checkToker.attach(file);
+      std::vector<TokenRecord> fullPass;
+      for (TokenRecord record = checkToker.getTokRecord(); !record.empty(); record = checkToker.getTokRecord())
+        fullPass.push_back(record);
+      size_t target = fullPass.size() > 0 ? fullPass[fullPass.size() / 2].offset() : 0;
+      const TokenCheckpoint* pCheckpoint = checkToker.findCheckpoint(target);
+      same = pCheckpoint != nullptr && checkToker.seekOffset(target);
+      size_t line = pCheckpoint != nullptr ? pCheckpoint->line : 0;
+      auto iter = std::find_if(fullPass.begin(), fullPass.end(),
+        [&](const TokenRecord& record) { return same && record.offset() >= pCheckpoint->offset; });
+      numToks = 0;
+      for (TokenRecord record = checkToker.getTokRecord(); !record.empty(); record = checkToker.getTokRecord(), ++iter, ++numToks)
+        same = same && iter != fullPass.end() && record.offset() == iter->offset() && record.text.size == iter->text.size;
+      same = same && iter == fullPass.end();
+      std::cout << "\n  " << (useTable ? "table" : "states") << " engine: " << checkToker.checkpoints().size()
+        << " checkpoints, " << numToks << " tokens lexed again from line " << line << " match: " << std::boolalpha << same;
+    }
   }
   catch (std::logic_error& ex)
   {
@@ -24,14 +24,166 @@
 * This is a new version, based on the State Design Pattern.  Older versions
 * exist, based on an informal state machine design.
 *
+* Toker can also attach to a caller-owned buffer or a MappedFile.  Then
+* the states scan the bytes directly with pointer arithmetic, but still
+* return exactly the tokens and line counts of the stream input.
+*
+* Toker::useTableEngine() switches to a TableLexer that replaces the
+* virtual state objects with a char class table and a switch.  Both
+* engines return identical token sequences.
+*
+* Toker::getTokView() returns a TokenView, a pointer, size, and offset,
+* instead of a std::string.  For buffer input it points into the buffer,
+* so a token costs no allocation or copy.  The states only note where
+* a buffered token ends, and getTok() copies it into a string.
+*
+* Toker::getTokRecord() returns the view with a TokenKind tag, e.g.,
+* keyword, punctuator, or comment, set by the state that ate the token,
+* so clients don't have to re-examine the text to classify it.
+*
+* Toker::getToks() collects up to max tokens into a TokenBuffer in one
+* call, so clients that want many tokens, like SemiExp, make one call
+* per batch instead of one per token.
+*
+* Toker::attach(IByteSource*, memoryLimit) reads any source, e.g., a
+* pipe or a file too large to map, through a fixed size window, so
+* the Toker's memory stays under memoryLimit however long the input.
+* A token too long for that limit, e.g., a huge string literal, keeps
+* its first and last chars, loses its middle, and is reported by
+* diagnostics().
+*
+* Toker::setConditionals() gives buffer input the macros known to be
+* defined or undefined.  Regions of #if groups those macros make
+* inactive are skipped without producing tokens, and lines stay exact.
+*
+* Toker::recordComments() keeps a CommentSpan, the offset, size, and
+* kind, of every comment, whether or not comments are returned as
+* tokens.  commentText() makes a string of a span only when asked.
+* IByteSource input keeps the text too, so it keeps only the most recent
+* comments, within a quarter of memoryLimit.
+*
+* Toker never throws on bad input.  UTF-8 sequences are identifier
+* chars, and bytes that are neither valid UTF-8 nor printable ASCII are
+* skipped like whitespace and reported by diagnostics().  A quoted
+* literal ends at its closing quote or at the end of its line, unless
+* a backslash continues it, so lexing time stays linear.
+*
+* A number is one token, as the C++ preprocessor sees it: 1.5e-10f,
+* 0x1Fu, .5, and 1'000'000 are not split at '.', '-', or the digit
+* separators.  A raw string, R"delim(...)delim", is one string token,
+* whatever quotes and newlines it contains.
+*
+* Operators are split by maximal munch, as a C++ compiler splits them:
+* "->*", "<<=", "!=", and "..." are single tokens, and ");" is two.
+* Special tokens that are punctuators can only add two char tokens to
+* the operators, so setSpecialTokens() matters most for newlines.
+*
+* Toker is an ITokenSource, the batch interface SemiExp reads, so a
+* TokenTee, which shares one Toker's batches with several clients, can
+* stand in for it.
+*
+* Toker::returnDirectives() makes each preprocessor directive, from its
+* '#' through its spliced lines, one directive token, ending before
+* the line end or a trailing C++ comment.  readDirectiveToken(), in
+* Conditionals, gives its kind, e.g., define or include, and argument.
+*
+* Toker::recordCheckpoints() makes buffer input keep a TokenCheckpoint,
+* an offset, its line, and the open #if groups, each interval bytes as
+* it is lexed.  seekOffset() and seekLine() restore the last checkpoint
+* at or before a place, so an editor or indexer can re-lex from there,
+* getting the tokens a full pass would, instead of starting over.
+*
 * Build Process:
 * --------------
-* Required Files: Tokenizer.h, Tokenizer.cpp
+* Required Files: Tokenizer.h, Tokenizer.cpp, MappedFile.h, MappedFile.cpp,
+*                 CharScan.h, CharScan.cpp, SpecialTokens.h, SpecialTokens.cpp,
+*                 TokenTable.h, TokenTable.cpp, LineIndex.h, LineIndex.cpp,
+*                 ByteSource.h, ByteSource.cpp, Conditionals.h, Conditionals.cpp
 *
 * Build Command: devenv Tokenizer.sln /rebuild debug
 *
 * Maintenance History:
 * --------------------
+* ver 6.3 : 18 Oct 2026
+* - getTokView(), getTokRecord(), and getToks() copy no chars of a
+*   buffered token
+* ver 6.2 : 18 Oct 2026
+* - recordComments() with IByteSource input keeps only recent comments,
+*   so the Toker stays within memoryLimit
+* ver 6.1 : 18 Oct 2026
+* - IByteSource input returns a token too long for memoryLimit with
+*   its middle dropped, and a diagnostic, instead of throwing
+* ver 6.0 : 18 Oct 2026
+* - added TokenCheckpoint, recordCheckpoints(), restore(), seekOffset(),
+*   and seekLine(), which resume lexing buffer input mid-file
+* ver 5.9 : 18 Oct 2026
+* - added ITokenSource, which Toker implements, and
+*   TokenBuffer::append(), so batches can be passed on and split
+* ver 5.8 : 18 Oct 2026
+* - added returnDirectives() and TokenKind::directive, so a directive
+*   can be a single record instead of a run of tokens
+* ver 5.7 : 18 Oct 2026
+* - each operator is one token, split from its neighbors by maximal
+*   munch, instead of a run of punctuator chars
+* ver 5.6 : 18 Oct 2026
+* - numbers, e.g., 1.5e-10f, 0x1Fu, or 1'000'000, and raw strings are
+*   each one token
+* ver 5.5 : 18 Oct 2026
+* - a quoted literal that isn't closed ends at its line end, and is
+*   reported by diagnostics(), so a stray quote can't swallow the
+*   rest of the file
+* ver 5.4 : 18 Oct 2026
+* - added recordComments(), comments(), and commentText(), which
+*   locate comments by span instead of copying their text
+* - isComment() tests the token's first two chars, so strings that
+*   contain "//" are no longer comments
+* ver 5.3 : 18 Oct 2026
+* - chars are classified without locale calls.  UTF-8 sequences are
+*   part of identifiers, malformed bytes are reported as diagnostics
+*   instead of throwing logic_error.
+* ver 5.2 : 18 Oct 2026
+* - added setConditionals().  Buffer input skips inactive #if regions,
+*   searching only for the next directive line.
+* ver 5.1 : 18 Oct 2026
+* - attach() restarts the states, so one Toker can be reattached to
+*   file after file, keeping its states and buffers
+* ver 5.0 : 18 Oct 2026
+* - added attach(IByteSource*, memoryLimit), a streaming input with a
+*   fixed read window, a token size limit, and a bounded line index
+* ver 4.9 : 18 Oct 2026
+* - tokens carry offsets only.  Line numbers come from a LineIndex:
+*   buffer input indexes its newlines in one pass when a line is first
+*   requested, so the lexer no longer counts them.  Added lineOf().
+* - attach() restarts the line count
+* ver 4.8 : 18 Oct 2026
+* - added TokenBuffer and getToks(), which collects a batch of tokens
+*   with their kinds and line counts in one call
+* ver 4.7 : 18 Oct 2026
+* - keywords are recognized with the fixed ids of TokenTable
+* ver 4.6 : 18 Oct 2026
+* - added TokenKind and getTokRecord().  Each state tags the tokens it
+*   eats, and classifyToken() tags tokens that arrive as strings.
+* ver 4.5 : 18 Oct 2026
+* - setSpecialTokens() compiles the list into an immutable SpecialTokens
+*   bit set, replacing the linear string searches.  Compiled sets can be
+*   shared between Tokers with setSpecialTokens(SpecialTokens::Ptr).
+* ver 4.4 : 18 Oct 2026
+* - added getTokView(), which returns a TokenView into the attached
+*   buffer instead of a new std::string, with the token's offset
+* - collectChar() returns false when it reaches the end of input, so
+*   comments and strings that end the input no longer end with EOF
+* ver 4.3 : 18 Oct 2026
+* - buffered whitespace, identifier, comment, and string scans use the
+*   SSE2/AVX2 run scanners in CharScan, chosen at run time
+* ver 4.2 : 18 Oct 2026
+* - added useTableEngine(), a table driven engine that classifies chars
+*   with a 256 entry table and runs the states from one switch, with no
+*   virtual dispatch or locale lookups.  It returns the same tokens as
+*   the ConsumeState classes.  See TokenizerBenchmark for a comparison.
+* ver 4.1 : 18 Oct 2026
+* - added attach(pBegin, pEnd) and attach(MappedFile) for buffer input.
+*   Buffered states scan runs with memchr and pointer loops instead of
+*   collecting one char at a time through the stream.
 * ver 4/0 : 17 Feb 2016
 * - modified EatDQString::eatChars() and EatSQString::eatChars() to properly
 *   handle repetition of escape char, '\', using isEscaped(tok) function.
@@ -73,34 +225,191 @@
 *
 * Planned Additions and Changes:
 * ------------------------------
-* - merge the oneCharacter and twoCharacter special Tokens into a
-*   single collection with a single setter method.
-* - consider replacing std::vector containers for special characteres
-*   with an unordered_map (hash table).
+* - none yet
 */
 #include <iosfwd>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace Scanner
 {
   class ConsumeState;    // private worker class
   struct Context;        // private shared data storage
+  class MappedFile;
+  class SpecialTokens;
+  class IByteSource;
+  class Conditionals;
+
+  ///////////////////////////////////////////////////////////////////
+  // TokenView refers to token text without owning it
+  // - offset is the position of the token's first char in the input
+  struct TokenView
+  {
+    const char* pData = "";
+    size_t size = 0;
+    size_t offset = 0;
+    bool empty() const { return size == 0; }
+    const char* begin() const { return pData; }
+    const char* end() const { return pData + size; }
+    char operator[](size_t i) const { return pData[i]; }
+    std::string str() const { return std::string(pData, size); }
+    bool operator==(const std::string& tok) const
+    {
+      return tok.size() == size && tok.compare(0, size, pData, size) == 0;
+    }
+    bool operator!=(const std::string& tok) const { return !(*this == tok); }
+  };
+
+  ///////////////////////////////////////////////////////////////////
+  // TokenKind is assigned once, by the state that collects the token
+  // - number is an alphanumeric token that starts with a digit
+  // - preprocHash is the # that starts a preprocessor directive
+  // - directive is a whole directive, returned by returnDirectives()
+  enum class TokenKind : unsigned char
+  {
+    none, identifier, keyword, number, punctuator, stringLiteral,
+    charLiteral, comment, newline, preprocHash, directive
+  };
+
+  ///////////////////////////////////////////////////////////////////
+  // TokenDiagnostic reports a malformed byte the lexer stepped over
+  // - message is static text, so recording one allocates nothing
+  struct TokenDiagnostic
+  {
+    size_t offset;
+    const char* message;
+  };
+
+  ///////////////////////////////////////////////////////////////////
+  // CommentSpan locates a comment in the input without copying it
+  // - size covers the comment's text, as a comment token would hold it
+  enum class CommentKind : unsigned char { cppComment, cComment };
+
+  struct CommentSpan
+  {
+    size_t offset = 0;
+    size_t size = 0;
+    CommentKind kind = CommentKind::cppComment;
+  };
+
+  ///////////////////////////////////////////////////////////////////
+  // TokenCheckpoint is where buffer input can be lexed again
+  // - offset is a token boundary, the first char a restored Toker eats
+  // - conditions are the open #if groups, with setConditionals()
+  struct TokenCheckpoint
+  {
+    size_t offset = 0;
+    size_t line = 1;
+    std::vector<unsigned char> conditions;
+  };
+
+  TokenKind classifyToken(const std::string& tok);
+  const char* kindName(TokenKind kind);
+
+  ///////////////////////////////////////////////////////////////////
+  // TokenRecord is a token's text, kind, and input offset
+  struct TokenRecord
+  {
+    TokenView text;
+    TokenKind kind = TokenKind::none;
+    size_t offset() const { return text.offset; }
+    bool empty() const { return text.empty(); }
+  };
+
+  ///////////////////////////////////////////////////////////////////
+  // TokenBuffer holds a batch of tokens filled by Toker::getToks()
+  // - buffer input: text refers to the attached buffer
+  // - stream input: text is copied into the TokenBuffer, and is
+  //   valid until the next getToks() or clear()
+  // - Toker::lineOf(buffer[n].offset()) is the nth token's line
+  class TokenBuffer
+  {
+  public:
+    size_t size() const { return _entries.size(); }
+    bool empty() const { return _entries.empty(); }
+    void clear() { _entries.clear(); _text.clear(); }
+    void append(const TokenBuffer& from, size_t first, size_t count);
+    TokenRecord operator[](size_t n) const
+    {
+      const Entry& entry = _entries[n];
+      TokenRecord record;
+      record.text.pData = entry.pData != nullptr ? entry.pData : _text.data() + entry.textPos;
+      record.text.size = entry.size;
+      record.text.offset = entry.offset;
+      record.kind = entry.kind;
+      return record;
+    }
+  private:
+    friend class Toker;
+    struct Entry
+    {
+      const char* pData;   // null if text is in _text
+      size_t textPos;
+      size_t size;
+      size_t offset;
+      TokenKind kind;
+    };
+    std::vector<Entry> _entries;
+    std::string _text;
+  };
+
+  ///////////////////////////////////////////////////////////////////
+  // ITokenSource supplies tokens in batches, e.g., to a SemiExp
+  // - getToks() returns 0 only at the end of input
+  // - lineOf() finds the line of a token it returned
+  class ITokenSource
+  {
+  public:
+    virtual ~ITokenSource() {}
+    virtual size_t getToks(TokenBuffer& buffer, size_t max) = 0;
+    virtual size_t lineOf(size_t offset) = 0;
+  };
 
-  class Toker
+  class Toker : public ITokenSource
   {
   public:
+    static const size_t defaultMemoryLimit = 256 * 1024;
+    static const size_t maxDiagnostics = 1024;   // kept, the rest are only counted
+    static const size_t defaultCheckpointInterval = 64 * 1024;
     Toker();
     Toker(const Toker&) = delete;
     ~Toker();
     Toker& operator=(const Toker&) = delete;
     bool attach(std::istream* pIn);
+    bool attach(const char* pBegin, const char* pEnd);
+    bool attach(const MappedFile& file);
+    bool attach(IByteSource* pSource, size_t memoryLimit = defaultMemoryLimit);
     std::string getTok();
+    TokenView getTokView();
+    TokenRecord getTokRecord();
+    size_t getToks(TokenBuffer& buffer, size_t max) override;
     bool canRead();
     void returnComments(bool doReturnComments = true);
+    void returnDirectives(bool doReturnDirectives = true);
     bool isComment(const std::string& tok);
     size_t currentLineCount();
+    size_t lineOf(size_t offset) override;
     void setSpecialTokens(const std::string& commaSeparatedString);
+    void setSpecialTokens(std::shared_ptr<const SpecialTokens> pSpecialTokens);
+    std::shared_ptr<const SpecialTokens> specialTokens();
+    void useTableEngine(bool doUseTableEngine = true);
+    void setConditionals(std::shared_ptr<const Conditionals> pConditionals);
+    void recordComments(bool doRecordComments = true);
+    const std::vector<CommentSpan>& comments();
+    std::string commentText(const CommentSpan& span);
+    void clearComments();
+    const std::vector<TokenDiagnostic>& diagnostics();
+    size_t diagnosticCount();
+    void clearDiagnostics();
+    void recordCheckpoints(size_t interval = defaultCheckpointInterval);
+    const std::vector<TokenCheckpoint>& checkpoints();
+    const TokenCheckpoint* findCheckpoint(size_t offset);
+    bool restore(const TokenCheckpoint& checkpoint);
+    bool seekOffset(size_t offset);
+    bool seekLine(size_t line);
   private:
+    bool nextTok();
     ConsumeState* pConsumer;
     Context* _pContext;
   };
@@ -0,0 +1,519 @@
+///////////////////////////////////////////////////////////////////////////////
+// TokenizerBenchmark.cpp - measures Toker throughput for each engine        //
+// ver 1.6                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Loads source files into memory, then tokenizes all of them repeatedly
+* with a fresh Toker per file and reports the elapsed wall clock time.
+* The test stub benchmarks both engines with both input modes, and the
+* buffer input run scanners at each supported SIMD level, and a
+* StaticToker, and checks that they all agree on the token count.
+*
+* The stub runs the loaded files and each synthetic corpus, and with
+* "--json fileSpec" also writes every result as JSON.  Allocations are
+* counted only when this file is built as the benchmark executable, by
+* replacing the global operator new.
+*
+* Synthetic corpora are generated from fixed text fragments chosen by a
+* std::minstd_rand with a fixed seed, so every platform and every run
+* generates the same bytes.
+*
+* Build Process:
+* --------------
+* Required Files: TokenizerBenchmark.h, TokenizerBenchmark.cpp,
+*                 Tokenizer.h, Tokenizer.cpp, MappedFile.h, MappedFile.cpp,
+*                 CharScan.h, CharScan.cpp, SpecialTokens.h, SpecialTokens.cpp,
+*                 TokenTable.h, TokenTable.cpp, LineIndex.h, LineIndex.cpp,
+*                 StaticToker.h, StaticToker.cpp, Utilities.h, Utilities.cpp
+*
+* Build Command: devenv Project2HelperCode.sln /rebuild release
+*
+* Maintenance History:
+* --------------------
+* ver 1.6 : 18 Oct 2026
+* - only stream input copies each source into an istringstream, so
+*   buffer, view, and batch timings no longer include that copy
+* ver 1.5 : 18 Oct 2026
+* - added warmup passes, ns/token and allocations/token, generated
+*   corpora, and JSON output
+* ver 1.4 : 18 Oct 2026
+* - added the fixed engine, a StaticToker configured at compile time
+* ver 1.3 : 18 Oct 2026
+* - added batch input, buffer input read with getToks()
+* ver 1.2 : 18 Oct 2026
+* - added view input, buffer input read with getTokView()
+* ver 1.1 : 18 Oct 2026
+* - added run scanner comparison for each SIMD level
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include "TokenizerBenchmark.h"
+#include "../Tokenizer/Tokenizer.h"
+#include "../Tokenizer/CharScan.h"
+#include "../Tokenizer/StaticToker.h"
+
+using namespace Scanner;
+
+namespace
+{
+  struct BenchConfig : CppTokenConfig
+  {
+    static const bool returnComments = true;   // as the Tokers in tokenize()
+  };
+
+  std::atomic<size_t> allocationCount(0);
+
+  const char* engineName(BenchEngine engine)
+  {
+    switch (engine)
+    {
+    case BenchEngine::table:
+      return "table ";
+    case BenchEngine::fixed:
+      return "fixed ";
+    default:
+      return "states";
+    }
+  }
+
+  const char* inputName(BenchInput input)
+  {
+    switch (input)
+    {
+    case BenchInput::buffer:
+      return "buffer";
+    case BenchInput::view:
+      return "view  ";
+    case BenchInput::batch:
+      return "batch ";
+    default:
+      return "stream";
+    }
+  }
+
+  std::string trimmed(const char* name)
+  {
+    std::string text = name;
+    return text.substr(0, text.find(' '));
+  }
+}
+
+//----< count every heap allocation of the benchmark executable >----
+
+#ifdef TEST_TOKENIZERBENCHMARK
+
+// gcc inlines a delete defined here into the library's deallocations,
+// then warns that free() is given memory from operator new
+#ifdef __GNUC__
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+void* operator new(size_t size)
+{
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  void* pMem = std::malloc(size > 0 ? size : 1);
+  if (pMem == nullptr)
+    throw std::bad_alloc();
+  return pMem;
+}
+
+BENCH_NOINLINE void operator delete(void* pMem) noexcept
+{
+  std::free(pMem);
+}
+
+BENCH_NOINLINE void operator delete(void* pMem, size_t) noexcept
+{
+  std::free(pMem);
+}
+
+#endif
+
+//----< are allocations counted in this build? >--------------------
+
+bool TokenizerBenchmark::countsAllocations()
+{
+#ifdef TEST_TOKENIZERBENCHMARK
+  return true;
+#else
+  return false;
+#endif
+}
+//----< read whole file into memory, excluded from timing >----------
+
+bool TokenizerBenchmark::addFile(const std::string& fileSpec)
+{
+  std::ifstream in(fileSpec, std::ios::binary);
+  if (!in.good())
+    return false;
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  _sources.push_back(contents.str());
+  return true;
+}
+//----< total size of the loaded sources >---------------------------
+
+size_t TokenizerBenchmark::byteCount() const
+{
+  size_t bytes = 0;
+  for (auto& source : _sources)
+    bytes += source.size();
+  return bytes;
+}
+//----< extract all tokens from one source, returning their number >-
+
+size_t TokenizerBenchmark::tokenize(const std::string& source, BenchEngine engine, BenchInput input)
+{
+  size_t numToks = 0;
+  if (engine == BenchEngine::fixed)
+  {
+    StaticToker<BenchConfig> staticToker;
+    staticToker.attach(source.data(), source.data() + source.size());
+    while (!staticToker.getTokRecord().empty())
+      ++numToks;
+    return numToks;
+  }
+  Toker toker;
+  toker.returnComments();
+  if (engine == BenchEngine::table)
+    toker.useTableEngine();
+  std::istringstream in;       // only stream input copies the source
+  if (input == BenchInput::stream)
+  {
+    in.str(source);
+    toker.attach(&in);
+  }
+  else
+    toker.attach(source.data(), source.data() + source.size());
+
+  if (input == BenchInput::view)
+  {
+    while (!toker.getTokView().empty())
+      ++numToks;
+    return numToks;
+  }
+  if (input == BenchInput::batch)
+  {
+    TokenBuffer batch;
+    while (toker.getToks(batch, 256) > 0)
+      numToks += batch.size();
+    return numToks;
+  }
+  while (true)
+  {
+    std::string tok = toker.getTok();
+    if (tok.size() > 0)
+      ++numToks;
+    else if (!toker.canRead())
+      break;
+  }
+  return numToks;
+}
+//----< time repetitions passes over all loaded files >--------------
+/*
+ * warmups untimed passes come first, so caches, the branch predictor,
+ * and the run scanner selection are settled before timing starts.
+ */
+BenchResult TokenizerBenchmark::run(BenchEngine engine, BenchInput input, size_t repetitions, size_t warmups)
+{
+  BenchResult result = { _corpusName, engine, input, repetitions, 0, 0, 0.0, 0 };
+  for (size_t i = 0; i < warmups; ++i)
+  {
+    for (auto& source : _sources)
+      tokenize(source, engine, input);
+  }
+  size_t allocationsBefore = allocationCount.load();
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < repetitions; ++i)
+  {
+    for (auto& source : _sources)
+    {
+      result.tokens += tokenize(source, engine, input);
+      result.bytes += source.size();
+    }
+  }
+  auto stop = std::chrono::steady_clock::now();
+  result.seconds = std::chrono::duration<double>(stop - start).count();
+  result.allocations = allocationCount.load() - allocationsBefore;
+  return result;
+}
+//----< display one result line >------------------------------------
+
+void TokenizerBenchmark::show(const BenchResult& result)
+{
+  std::cout << "\n  " << engineName(result.engine) << " engine, " << inputName(result.input)
+    << " input: " << std::setw(10) << result.tokens << " tokens in "
+    << std::fixed << std::setprecision(3) << std::setw(7) << result.seconds << " sec, "
+    << std::setprecision(0) << std::setw(10) << result.tokensPerSec() << " tokens/sec, "
+    << std::setprecision(1) << std::setw(6) << result.megaBytesPerSec() << " MB/sec, "
+    << std::setw(6) << result.nanoSecsPerToken() << " ns/token";
+  if (countsAllocations())
+    std::cout << ", " << std::setprecision(3) << result.allocationsPerToken() << " allocs/token";
+}
+//----< name used for a generated corpus in results >---------------
+
+const char* TokenizerBenchmark::corpusName(BenchCorpus kind)
+{
+  switch (kind)
+  {
+  case BenchCorpus::small:
+    return "small";
+  case BenchCorpus::headerHeavy:
+    return "header-heavy";
+  case BenchCorpus::commentHeavy:
+    return "comment-heavy";
+  case BenchCorpus::stringHeavy:
+    return "string-heavy";
+  default:
+    return "giant";
+  }
+}
+//----< generate a repeatable synthetic source of about bytes >------
+/*
+ * bytes == 0 selects the corpus's usual size.  Each corpus draws from
+ * its own fragments, and the giant corpus from all of them.
+ */
+std::string TokenizerBenchmark::generateCorpus(BenchCorpus kind, size_t bytes)
+{
+  static const char* code[] = {
+    "int count = 0;\n",
+    "for (size_t i = 0; i < items.size(); ++i)\n  total += items[i] * 3;\n",
+    "if (pNode->left != nullptr && depth >= 16)\n{\n  return visit(pNode->left, depth - 1);\n}\n",
+    "while (first != last)\n  *out++ = transform(*first++);\n",
+    "x = (a << 2) + (b >> 1) - c % 7;\n",
+    "std::vector<std::string> names{ \"a\", \"b\" };\n",
+  };
+  static const char* headers[] = {
+    "#include <vector>\n", "#include \"Tokenizer.h\"\n", "#ifndef WIDGET_H\n#define WIDGET_H\n#endif\n",
+    "namespace Widgets\n{\n  class Widget;\n}\n",
+    "template <typename T, typename Alloc = std::allocator<T>>\nclass Pool\n{\npublic:\n"
+    "  explicit Pool(size_t capacity);\n  virtual ~Pool();\n  T* acquire() const;\n"
+    "  void release(T* pItem) noexcept;\nprivate:\n  size_t _capacity = 0;\n};\n",
+    "using Map = std::unordered_map<std::string, std::shared_ptr<const Widget>>;\n",
+    "extern const int maxWidgets;\nenum class Color : unsigned char { red, green, blue };\n",
+  };
+  static const char* comments[] = {
+    "/*\n * Package Operations:\n * -------------------\n * Describes what the package does, at some length.\n */\n",
+    "// a line comment explaining the next statement\n",
+    "/////////////////////////////////////////////////////////////////////\n",
+    "int value;  // trailing comment\n",
+    "/* inline */ call(/* arg */ 1);\n",
+    "//----< documented function >---------------------------------------\n",
+  };
+  static const char* strings[] = {
+    "const char* pMessage = \"an ordinary message, with no escapes at all\";\n",
+    "std::cout << \"\\n  \" << name << \": \\\"\" << value << \"\\\"\";\n",
+    "path = \"C:\\\\Users\\\\someone\\\\file.txt\";\n",
+    "char quote = '\\'', slash = '\\\\', newline = '\\n';\n",
+    "std::string json = \"{ \\\"key\\\": \\\"value\\\", \\\"list\\\": [1, 2, 3] }\";\n",
+  };
+  struct Fragments
+  {
+    const char** pTexts;
+    size_t count;
+  };
+  const Fragments pools[] = {     // each corpus uses a range of these
+    { headers, sizeof(headers) / sizeof(*headers) }, { code, sizeof(code) / sizeof(*code) },
+    { comments, sizeof(comments) / sizeof(*comments) }, { strings, sizeof(strings) / sizeof(*strings) }
+  };
+  size_t first = 0;
+  size_t count = 4;
+  size_t defaultBytes = 256 * 1024;
+  switch (kind)
+  {
+  case BenchCorpus::small:
+    first = 1;
+    count = 2;
+    defaultBytes = 4 * 1024;
+    break;
+  case BenchCorpus::headerHeavy:
+    count = 1;
+    break;
+  case BenchCorpus::commentHeavy:
+    first = 2;
+    count = 1;
+    break;
+  case BenchCorpus::stringHeavy:
+    first = 3;
+    count = 1;
+    break;
+  default:
+    defaultBytes = 32 * 1024 * 1024;
+    break;
+  }
+  if (bytes == 0)
+    bytes = defaultBytes;
+  std::minstd_rand random(687);
+  std::string source;
+  source.reserve(bytes + 512);
+  while (source.size() < bytes)
+  {
+    const Fragments& pool = pools[first + random() % count];
+    source += pool.pTexts[random() % pool.count];
+  }
+  return source;
+}
+//----< write results as a JSON object holding a results array >----
+
+void TokenizerBenchmark::writeJson(std::ostream& out, const std::vector<BenchResult>& results)
+{
+  out << "{\n  \"scanLevel\": \"" << scanLevelName(scanLevel()) << "\",\n"
+    << "  \"countsAllocations\": " << (countsAllocations() ? "true" : "false") << ",\n"
+    << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const BenchResult& result = results[i];
+    out << (i > 0 ? "," : "") << "\n    { "
+      << "\"corpus\": \"" << result.corpus << "\", "
+      << "\"engine\": \"" << trimmed(engineName(result.engine)) << "\", "
+      << "\"input\": \"" << trimmed(inputName(result.input)) << "\", "
+      << "\"repetitions\": " << result.repetitions << ", "
+      << "\"tokens\": " << result.tokens << ", "
+      << "\"bytes\": " << result.bytes << ", "
+      << std::fixed << std::setprecision(6)
+      << "\"seconds\": " << result.seconds << ", "
+      << std::setprecision(3)
+      << "\"megaBytesPerSec\": " << result.megaBytesPerSec() << ", "
+      << "\"tokensPerSec\": " << result.tokensPerSec() << ", "
+      << "\"nanoSecsPerToken\": " << result.nanoSecsPerToken() << ", "
+      << "\"allocationsPerToken\": " << result.allocationsPerToken() << " }";
+  }
+  out << "\n  ]\n}\n";
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TOKENIZERBENCHMARK
+
+#include "../Utilities/Utilities.h"
+
+using Helper = Utilities::StringHelper;
+
+//----< run every engine and input on one corpus >-------------------
+/*
+ * Repetitions are chosen so each run tokenizes about 16 MB.
+ */
+bool runCorpus(TokenizerBenchmark& bench, std::vector<BenchResult>& results)
+{
+  size_t bytes = std::max<size_t>(bench.byteCount(), 1);
+  size_t repetitions = std::max<size_t>(16 * 1024 * 1024 / bytes, 1);
+  std::cout << "\n\n  " << bench.corpusName() << ": " << bench.fileCount() << " sources, "
+    << bench.byteCount() << " bytes, " << repetitions << " repetitions";
+  size_t first = results.size();
+  for (BenchInput input : { BenchInput::stream, BenchInput::buffer, BenchInput::view, BenchInput::batch })
+  {
+    for (BenchEngine engine : { BenchEngine::states, BenchEngine::table })
+    {
+      results.push_back(bench.run(engine, input, repetitions));
+      bench.show(results.back());
+    }
+  }
+  results.push_back(bench.run(BenchEngine::fixed, BenchInput::view, repetitions));
+  bench.show(results.back());
+
+  bool same = true;
+  for (size_t i = first; i < results.size(); ++i)
+    same = same && results[i].tokens == results[first].tokens;
+  return same;
+}
+
+int main(int argc, char* argv[])
+{
+  Helper::Title("Benchmarking Tokenizer engines");
+
+  std::string jsonSpec;
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+    if (arg == "--json" && i + 1 < argc)
+      jsonSpec = argv[++i];
+    else
+      files.push_back(arg);
+  }
+  if (files.size() == 0)
+  {
+    files = {
+      "../Tokenizer/Tokenizer.cpp", "../Tokenizer/Tokenizer.h",
+      "../SemiExp/SemiExp.cpp", "../Parser/Parser.cpp",
+      "../Parser/ActionsAndRules.h", "../Utilities/Utilities.cpp"
+    };
+  }
+  TokenizerBenchmark bench;
+  for (auto& file : files)
+  {
+    if (!bench.addFile(file))
+      std::cout << "\n  can't open " << file;
+  }
+
+  std::vector<BenchResult> results;
+  bool same = true;
+  if (bench.fileCount() > 0)
+  {
+    same = runCorpus(bench, results) && same;
+
+    std::cout << "\n\n  buffer input run scanners, best is " << scanLevelName(bestScanLevel());
+    size_t repetitions = results[0].repetitions;
+    for (ScanLevel level : { ScanLevel::scalar, ScanLevel::sse2, ScanLevel::avx2 })
+    {
+      if (level > bestScanLevel())
+        break;
+      setScanLevel(level);
+      std::cout << "\n  " << scanLevelName(level) << " run scanners:";
+      BenchResult result = bench.run(BenchEngine::table, BenchInput::buffer, repetitions);
+      bench.show(result);
+      same = same && result.tokens == results[0].tokens;
+    }
+    setScanLevel(bestScanLevel());
+
+    std::cout << "\n\n  table engine speedup, stream input: " << std::setprecision(2)
+      << results[1].tokensPerSec() / results[0].tokensPerSec();
+    std::cout << "\n  table engine speedup, buffer input: "
+      << results[3].tokensPerSec() / results[2].tokensPerSec();
+    std::cout << "\n  table engine speedup, view input:   "
+      << results[5].tokensPerSec() / results[4].tokensPerSec();
+    std::cout << "\n  table engine speedup, batch input:  "
+      << results[7].tokensPerSec() / results[6].tokensPerSec();
+    std::cout << "\n  StaticToker speedup over table view:  "
+      << results[8].tokensPerSec() / results[5].tokensPerSec();
+  }
+
+  for (BenchCorpus kind : { BenchCorpus::small, BenchCorpus::headerHeavy, BenchCorpus::commentHeavy,
+    BenchCorpus::stringHeavy, BenchCorpus::giant })
+  {
+    TokenizerBenchmark generated(TokenizerBenchmark::corpusName(kind));
+    generated.addSource(TokenizerBenchmark::generateCorpus(kind));
+    same = runCorpus(generated, results) && same;
+  }
+  std::cout << "\n\n  all engines return the same number of tokens: " << std::boolalpha << same;
+
+  if (jsonSpec.size() > 0)
+  {
+    std::ofstream json(jsonSpec);
+    TokenizerBenchmark::writeJson(json, results);
+    std::cout << "\n  results written to " << jsonSpec;
+  }
+  std::cout << "\n\n";
+  return same ? 0 : 1;
+}
+#endif
@@ -0,0 +1,110 @@
+#ifndef TOKENIZERBENCHMARK_H
+#define TOKENIZERBENCHMARK_H
+///////////////////////////////////////////////////////////////////////////////
+// TokenizerBenchmark.h - measures Toker throughput for each engine          //
+// ver 1.5                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a TokenizerBenchmark class that loads a set of
+* source files into memory and times how fast Toker extracts their
+* tokens.  Each run reports tokens/sec and MB/sec for one engine,
+* ConsumeState classes, TableLexer, or a StaticToker, and one input
+* mode: stream, buffer, buffer read through getTokView(), or buffer
+* read in batches through getToks().  StaticToker reads buffers only.
+*
+* Each run starts with untimed warmup passes, then reports MB/sec,
+* tokens/sec, ns/token, and heap allocations per token.  Allocations are
+* counted by the benchmark executable's replacement operator new.
+*
+* generateCorpus() makes repeatable synthetic sources: a small file, and
+* header heavy, comment heavy, string literal heavy, and giant mixed
+* ones.  writeJson() writes results in a form that runs on different
+* commits can be compared with.  Files are read once before timing, so the numbers
+* exclude disk I/O.
+*
+* Public Interface:
+* -----------------
+* TokenizerBenchmark bench;
+* bench.addFile("../Tokenizer/Tokenizer.cpp");
+* BenchResult states = bench.run(BenchEngine::states, BenchInput::buffer, 10);
+* BenchResult table = bench.run(BenchEngine::table, BenchInput::buffer, 10);
+* bench.show(states);
+* TokenizerBenchmark strings("strings");
+* strings.addSource(TokenizerBenchmark::generateCorpus(BenchCorpus::stringHeavy));
+* TokenizerBenchmark::writeJson(std::cout, { states, table });
+*
+* Build Process:
+* --------------
+* Required Files: TokenizerBenchmark.h, TokenizerBenchmark.cpp,
+*                 Tokenizer.h, Tokenizer.cpp, MappedFile.h, MappedFile.cpp,
+*                 CharScan.h, CharScan.cpp, SpecialTokens.h, SpecialTokens.cpp,
+*                 TokenTable.h, TokenTable.cpp, LineIndex.h, LineIndex.cpp,
+*                 StaticToker.h, StaticToker.cpp, Utilities.h, Utilities.cpp
+*
+* Build Command: devenv Project2HelperCode.sln /rebuild release
+*
+* Maintenance History:
+* --------------------
+* ver 1.5 : 18 Oct 2026
+* - added warmup passes, ns/token and allocations/token, synthetic
+*   corpora, and JSON output
+* ver 1.4 : 18 Oct 2026
+* - added BenchEngine::fixed, a StaticToker with Toker's defaults
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace Scanner
+{
+  enum class BenchEngine { states, table, fixed };
+  enum class BenchInput { stream, buffer, view, batch };
+  enum class BenchCorpus { small, headerHeavy, commentHeavy, stringHeavy, giant };
+
+  struct BenchResult
+  {
+    std::string corpus;
+    BenchEngine engine;
+    BenchInput input;
+    size_t repetitions;
+    size_t tokens;
+    size_t bytes;
+    double seconds;
+    size_t allocations;
+    double tokensPerSec() const { return seconds > 0 ? tokens / seconds : 0; }
+    double megaBytesPerSec() const { return seconds > 0 ? bytes / seconds / 1.0e6 : 0; }
+    double nanoSecsPerToken() const { return tokens > 0 ? seconds * 1.0e9 / tokens : 0; }
+    double allocationsPerToken() const { return tokens > 0 ? static_cast<double>(allocations) / tokens : 0; }
+  };
+
+  class TokenizerBenchmark
+  {
+  public:
+    TokenizerBenchmark(const std::string& corpusName = "files") : _corpusName(corpusName) {}
+    bool addFile(const std::string& fileSpec);
+    void addSource(const std::string& source) { _sources.push_back(source); }
+    size_t fileCount() const { return _sources.size(); }
+    size_t byteCount() const;
+    const std::string& corpusName() const { return _corpusName; }
+    BenchResult run(BenchEngine engine, BenchInput input, size_t repetitions, size_t warmups = 1);
+    void show(const BenchResult& result);
+    static std::string generateCorpus(BenchCorpus kind, size_t bytes = 0);
+    static const char* corpusName(BenchCorpus kind);
+    static void writeJson(std::ostream& out, const std::vector<BenchResult>& results);
+    static bool countsAllocations();
+  private:
+    size_t tokenize(const std::string& source, BenchEngine engine, BenchInput input);
+    std::string _corpusName;
+    std::vector<std::string> _sources;
+  };
+}
+#endif
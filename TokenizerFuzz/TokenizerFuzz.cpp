@@ -0,0 +1,535 @@
+///////////////////////////////////////////////////////////////////////////////
+// TokenizerFuzz.cpp - differential fuzzing of the Toker engines             //
+// ver 1.2                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* check() tokenizes the input once with the reference, a ConsumeState
+* Toker reading a std::istringstream, then with each alternative, and
+* compares them token by token.  Tokens are copied out as FuzzTokens,
+* since a stream Toker's views are only valid until its next token.
+*
+* The IByteSource engines read a TrickleSource, which returns 1 to 7
+* bytes a call, so nearly every token crosses a window refill.  Its
+* memoryLimit is large enough that no token of the input can exceed it.
+*
+* The test stub checks random and mutated inputs, and with file
+* arguments uses them as the seeds.  It prints the first divergence,
+* with the input as escaped text, and returns 1 if it finds one.
+*
+* Build Process:
+* --------------
+* Required Files: TokenizerFuzz.h, TokenizerFuzz.cpp, and the Tokenizer
+*                 package files, Utilities.h, Utilities.cpp
+*
+* Build Command: devenv Project2HelperCode.sln /rebuild debug
+*
+* Maintenance History:
+* --------------------
+* ver 1.2 : 18 Oct 2026
+* - added the statesResumed and tableResumed engines, which lex again
+*   from the checkpoint before the middle of the input
+* ver 1.1 : 18 Oct 2026
+* - each input is also checked with directives returned as records
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "TokenizerFuzz.h"
+#include "../Tokenizer/ByteSource.h"
+#include "../Tokenizer/CharScan.h"
+#include "../Tokenizer/ParallelToker.h"
+#include "../Tokenizer/StaticToker.h"
+
+using namespace Scanner;
+
+namespace
+{
+  struct CommentConfig : CppTokenConfig
+  {
+    static const bool returnComments = true;
+  };
+
+  struct DirectiveConfig : CommentConfig
+  {
+    static const bool returnDirectives = true;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // FuzzMode: the Toker options each input is checked with
+
+  struct FuzzMode
+  {
+    bool doReturnComments;
+    bool doReturnDirectives;
+  };
+
+  const FuzzMode fuzzModes[] = { { false, false }, { true, false }, { true, true } };
+
+  /////////////////////////////////////////////////////////////////////
+  // TrickleSource: returns a string a few bytes at a time
+
+  class TrickleSource : public IByteSource
+  {
+  public:
+    TrickleSource(const std::string& text) : _text(text) {}
+    size_t read(char* pDest, size_t max) override
+    {
+      size_t count = std::min(std::min(max, _text.size() - _pos), 1 + _pos % 7);
+      std::memcpy(pDest, _text.data() + _pos, count);
+      _pos += count;
+      return count;
+    }
+  private:
+    const std::string& _text;
+    size_t _pos = 0;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // FuzzOutput: everything an engine returned for one input
+
+  struct FuzzOutput
+  {
+    std::vector<FuzzToken> toks;
+    std::vector<TokenDiagnostic> diagnostics;
+    size_t diagnosticCount = 0;
+    bool hasDiagnostics = true;   // ParallelToker doesn't report them
+    std::string exception;
+  };
+
+  void append(FuzzOutput& output, const TokenRecord& record)
+  {
+    output.toks.push_back(FuzzToken{ record.text.str(), record.kind, record.offset() });
+  }
+
+  bool isTable(FuzzEngine engine)
+  {
+    return engine == FuzzEngine::tableStream || engine == FuzzEngine::tableBuffer
+      || engine == FuzzEngine::tableSource || engine == FuzzEngine::tableBatch
+      || engine == FuzzEngine::tableResumed;
+  }
+
+  //----< tokenize with a StaticToker configured by Config >----------
+
+  template <typename Config>
+  void lexStatic(const std::string& input, FuzzOutput& output)
+  {
+    StaticToker<Config> toker;
+    toker.attach(input.data(), input.data() + input.size());
+    for (TokenRecord record = toker.getTokRecord(); !record.empty(); record = toker.getTokRecord())
+      append(output, record);
+    output.diagnostics = toker.diagnostics();
+    output.diagnosticCount = toker.diagnosticCount();
+  }
+  //----< tokenize with a Toker attached as engine says >-------------
+
+  void lexToker(FuzzEngine engine, const std::string& input, const FuzzMode& mode, FuzzOutput& output)
+  {
+    Toker toker;
+    toker.useTableEngine(isTable(engine));
+    toker.returnComments(mode.doReturnComments);
+    toker.returnDirectives(mode.doReturnDirectives);
+    std::istringstream in(input);
+    TrickleSource source(input);
+    switch (engine)
+    {
+    case FuzzEngine::statesStream: case FuzzEngine::tableStream:
+      toker.attach(&in);
+      break;
+    case FuzzEngine::statesSource: case FuzzEngine::tableSource:
+      toker.attach(&source, std::max<size_t>(Toker::defaultMemoryLimit, 4 * (input.size() + 64)));
+      break;
+    default:
+      toker.attach(input.data(), input.data() + input.size());
+    }
+    if (engine == FuzzEngine::statesBatch || engine == FuzzEngine::tableBatch)
+    {
+      TokenBuffer buffer;
+      while (toker.getToks(buffer, 7) > 0)
+      {
+        for (size_t i = 0; i < buffer.size(); ++i)
+          append(output, buffer[i]);
+      }
+    }
+    else if (engine == FuzzEngine::statesResumed || engine == FuzzEngine::tableResumed)
+    {
+      toker.recordCheckpoints(16);
+      for (TokenRecord record = toker.getTokRecord(); !record.empty(); record = toker.getTokRecord())
+        append(output, record);
+      const TokenCheckpoint* pCheckpoint = toker.findCheckpoint(input.size() / 2);
+      size_t resumeAt = pCheckpoint != nullptr ? pCheckpoint->offset : 0;
+      if (!toker.seekOffset(input.size() / 2))
+        throw std::logic_error("no checkpoint to resume from");
+      while (output.toks.size() > 0 && output.toks.back().offset >= resumeAt)
+        output.toks.pop_back();
+      for (TokenRecord record = toker.getTokRecord(); !record.empty(); record = toker.getTokRecord())
+        append(output, record);
+    }
+    else
+    {
+      for (TokenRecord record = toker.getTokRecord(); !record.empty(); record = toker.getTokRecord())
+        append(output, record);
+    }
+    output.diagnostics = toker.diagnostics();
+    output.diagnosticCount = toker.diagnosticCount();
+  }
+  //----< tokenize input with engine, catching anything it throws >---
+
+  FuzzOutput lex(FuzzEngine engine, const std::string& input, const FuzzMode& mode)
+  {
+    FuzzOutput output;
+    try
+    {
+      if (engine == FuzzEngine::fixed)
+      {
+        if (mode.doReturnDirectives)
+          lexStatic<DirectiveConfig>(input, output);
+        else if (mode.doReturnComments)
+          lexStatic<CommentConfig>(input, output);
+        else
+          lexStatic<CppTokenConfig>(input, output);
+      }
+      else if (engine == FuzzEngine::parallel)
+      {
+        ParallelToker ptoker(2, 16);
+        ptoker.returnComments(mode.doReturnComments);
+        ptoker.returnDirectives(mode.doReturnDirectives);
+        std::vector<TokenRecord> toks;
+        ptoker.tokenize(input.data(), input.data() + input.size(), toks);
+        for (auto& record : toks)
+          append(output, record);
+        output.hasDiagnostics = false;
+      }
+      else
+      {
+        lexToker(engine, input, mode, output);
+      }
+    }
+    catch (std::exception& ex)
+    {
+      output.exception = ex.what();
+    }
+    return output;
+  }
+  //----< printable form of a token for divergence reports >----------
+
+  std::string escaped(const std::string& text)
+  {
+    static const char* hex = "0123456789ABCDEF";
+    std::string result;
+    for (char c : text)
+    {
+      unsigned char ch = static_cast<unsigned char>(c);
+      if (ch == '\n')
+        result += "\\n";
+      else if (ch == '\\' || ch == '\"')
+        (result += '\\') += c;
+      else if (ch >= ' ' && ch < 127)
+        result += c;
+      else
+        ((result += "\\x") += hex[ch >> 4]) += hex[ch & 15];
+    }
+    return result;
+  }
+
+  std::string describe(const FuzzToken* pTok)
+  {
+    if (pTok == nullptr)
+      return "end of input";
+    std::ostringstream out;
+    out << kindName(pTok->kind) << " \"" << escaped(pTok->text) << "\" at " << pTok->offset;
+    return out.str();
+  }
+  //----< first difference of output from expected, empty if none >--
+
+  std::string compare(const FuzzOutput& expected, const FuzzOutput& output)
+  {
+    if (output.exception.size() > 0)
+      return "threw \"" + output.exception + "\"";
+    size_t count = std::max(expected.toks.size(), output.toks.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+      const FuzzToken* pExpected = i < expected.toks.size() ? &expected.toks[i] : nullptr;
+      const FuzzToken* pActual = i < output.toks.size() ? &output.toks[i] : nullptr;
+      if (pExpected != nullptr && pActual != nullptr && pExpected->text == pActual->text
+        && pExpected->kind == pActual->kind && pExpected->offset == pActual->offset)
+        continue;
+      std::ostringstream out;
+      out << "token " << i << ": expected " << describe(pExpected) << ", got " << describe(pActual);
+      return out.str();
+    }
+    if (!output.hasDiagnostics)
+      return "";
+    std::ostringstream out;
+    if (expected.diagnosticCount != output.diagnosticCount
+      || expected.diagnostics.size() != output.diagnostics.size())
+    {
+      out << "expected " << expected.diagnosticCount << " diagnostics, got " << output.diagnosticCount;
+      return out.str();
+    }
+    for (size_t i = 0; i < expected.diagnostics.size(); ++i)
+    {
+      const TokenDiagnostic& diag = expected.diagnostics[i];
+      const TokenDiagnostic& actual = output.diagnostics[i];
+      if (diag.offset == actual.offset && std::strcmp(diag.message, actual.message) == 0)
+        continue;
+      out << "diagnostic " << i << ": expected \"" << diag.message << "\" at " << diag.offset
+        << ", got \"" << actual.message << "\" at " << actual.offset;
+      return out.str();
+    }
+    return "";
+  }
+
+  const char* fragments[] = {
+    "int", "x_1", "caf\xC3\xA9", "std", "::", "<<", ">>", "++", "-=", "==", "->", "...",
+    " ", "\t", "\r\n", "\n", "{", "}", "(", ")", "[", "]", ";", ",", ".", "#", "#include <vector>\n",
+    "#define X(a) a##b\n", "#define M(a) a \\\n b\n", "  # if A // c\n", "#pragma /* a\nb */ once\n",
+    "\"text\"", "\"esc\\\"aped\"", "\"\\\\\"", "'c'", "'\\''", "L\"wide\"",
+    "// line comment\n", "/* block */", "/* two\nlines */", "/*", "*/", "//", "\"", "'", "\\",
+    "3.14e-2f", "0x1F", ".5", "1'000", "e+", "R\"(", ")\"", "u8R\"d(", ")d\"", "R\"0123456789abcdefg(",
+    "->*", ".*", "..", "<<=", ">>=", "<=", "!=", "&&", "||", "%=", "?", "!", "~", "@", "$",
+    "\xE2\x82\xAC", "\xF0\x9F\x98\x80",
+    "\xC3", "\xE2\x82", "\xF0\x9F\x98", "\x80", "\xFF", "\xC0\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80",
+    "\x01", "\x7F"
+  };
+  const size_t fragmentCount = sizeof(fragments) / sizeof(fragments[0]);
+}
+//----< name of an engine for reports >------------------------------
+
+const char* Scanner::fuzzEngineName(FuzzEngine engine)
+{
+  switch (engine)
+  {
+  case FuzzEngine::statesStream: return "states stream";
+  case FuzzEngine::statesBuffer: return "states buffer";
+  case FuzzEngine::statesSource: return "states source";
+  case FuzzEngine::statesBatch:  return "states batch";
+  case FuzzEngine::statesResumed: return "states resumed";
+  case FuzzEngine::tableStream:  return "table stream";
+  case FuzzEngine::tableBuffer:  return "table buffer";
+  case FuzzEngine::tableSource:  return "table source";
+  case FuzzEngine::tableBatch:   return "table batch";
+  case FuzzEngine::tableResumed: return "table resumed";
+  case FuzzEngine::parallel:     return "parallel";
+  default:                       return "fixed";
+  }
+}
+//----< describe divergence, with the input that caused it >--------
+
+std::string FuzzDivergence::str() const
+{
+  std::ostringstream out;
+  out << fuzzEngineName(engine) << " (" << scanLevel << ", comments "
+    << (returnsComments ? "returned" : "skipped") << ", directives "
+    << (returnsDirectives ? "returned" : "split") << ") " << what
+    << "\n  input: \"" << escaped(input) << "\"";
+  return out.str();
+}
+//----< load a seed source for mutation >----------------------------
+
+bool TokenizerFuzz::addSeedFile(const std::string& fileSpec)
+{
+  std::ifstream in(fileSpec, std::ios::binary);
+  if (!in.good())
+    return false;
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  _seeds.push_back(contents.str());
+  return true;
+}
+//----< do all engines return the reference tokens for input? >------
+/*
+ * The scan level is restored before returning, so check() can be
+ * called from tests that depend on it.
+ */
+bool TokenizerFuzz::check(const char* pData, size_t size)
+{
+  std::string input(pData, size);
+  ScanLevel saved = scanLevel();
+  bool same = true;
+  for (const FuzzMode& mode : fuzzModes)
+  {
+    FuzzOutput expected = lex(FuzzEngine::statesStream, input, mode);
+    _tokenCount += expected.toks.size();
+    for (int level = static_cast<int>(ScanLevel::scalar); same && level <= static_cast<int>(bestScanLevel()); ++level)
+    {
+      setScanLevel(static_cast<ScanLevel>(level));
+      for (int engine = static_cast<int>(FuzzEngine::statesBuffer); engine <= static_cast<int>(FuzzEngine::fixed); ++engine)
+      {
+        FuzzOutput output = lex(static_cast<FuzzEngine>(engine), input, mode);
+        std::string what = expected.exception.size() > 0
+          ? "reference threw \"" + expected.exception + "\"" : compare(expected, output);
+        if (what.empty())
+          continue;
+        _divergence.engine = static_cast<FuzzEngine>(engine);
+        _divergence.scanLevel = scanLevelName(static_cast<ScanLevel>(level));
+        _divergence.returnsComments = mode.doReturnComments;
+        _divergence.returnsDirectives = mode.doReturnDirectives;
+        _divergence.what = what;
+        _divergence.input = input;
+        same = false;
+        break;
+      }
+    }
+    if (!same)
+      break;
+  }
+  setScanLevel(saved);
+  return same;
+}
+//----< random sequence of C++ fragments and malformed bytes >-------
+
+std::string TokenizerFuzz::randomInput()
+{
+  std::string input;
+  size_t count = pick(40);
+  for (size_t i = 0; i < count; ++i)
+  {
+    size_t n = pick(fragmentCount + 2);
+    if (n == fragmentCount)
+      input += '\0';
+    else if (n == fragmentCount + 1)
+      input += static_cast<char>(pick(256));
+    else
+      input += fragments[n];
+  }
+  return input;
+}
+//----< source with a few bytes flipped or ranges changed >----------
+
+std::string TokenizerFuzz::mutate(const std::string& source)
+{
+  std::string input = source;
+  size_t count = 1 + pick(8);
+  for (size_t i = 0; i < count; ++i)
+  {
+    size_t pos = pick(input.size() + 1);
+    size_t size = std::min(input.size() - pos, 1 + pick(64));
+    switch (pick(5))
+    {
+    case 0:
+      if (pos < input.size())
+        input[pos] = static_cast<char>(input[pos] ^ (1 << pick(8)));
+      break;
+    case 1:
+      input.insert(pos, fragments[pick(fragmentCount)]);
+      break;
+    case 2:
+      input.erase(pos, size);
+      break;
+    case 3:
+      input.insert(pos, input.substr(pos, size));
+      break;
+    default:
+      input.resize(pos);
+    }
+  }
+  return input;
+}
+//----< check iterations inputs, stopping at first divergence >------
+/*
+ * Mutated seeds are cut to a random window of at most 4 KB, so each
+ * iteration stays quick however large the seed files are.
+ */
+size_t TokenizerFuzz::run(size_t iterations)
+{
+  for (size_t i = 0; i < iterations; ++i)
+  {
+    std::string input;
+    if (_seeds.size() > 0 && pick(2) == 0)
+    {
+      const std::string& seed = _seeds[pick(_seeds.size())];
+      size_t pos = pick(seed.size());
+      input = mutate(seed.substr(pos, 1 + pick(4096)));
+    }
+    else
+    {
+      input = randomInput();
+    }
+    if (!check(input))
+      return i + 1;
+  }
+  return iterations;
+}
+
+//----< libFuzzer entry point >--------------------------------------
+
+#ifdef TOKENIZERFUZZ_LIBFUZZER
+
+#include <cstdlib>
+#include <iostream>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* pData, size_t size)
+{
+  static TokenizerFuzz fuzz;
+  if (!fuzz.check(reinterpret_cast<const char*>(pData), size))
+  {
+    std::cerr << "\n  " << fuzz.divergence().str() << "\n";
+    std::abort();
+  }
+  return 0;
+}
+
+#endif
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_TOKENIZERFUZZ
+
+#include <iostream>
+#include "../Utilities/Utilities.h"
+
+using Helper = Utilities::StringHelper;
+
+int main(int argc, char* argv[])
+{
+  Helper::Title("Differential fuzzing of Tokenizer engines");
+
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; ++i)
+    files.push_back(argv[i]);
+  if (files.size() == 0)
+    files = { "../Tokenizer/Tokenizer.cpp", "../Tokenizer/Tokenizer.h", "../SemiExp/SemiExp.cpp" };
+
+  TokenizerFuzz fuzz(42);
+  for (auto& file : files)
+  {
+    if (!fuzz.addSeedFile(file))
+      std::cout << "\n  can't open " << file;
+  }
+
+  bool same = true;
+  for (auto& seed : fuzz.seeds())
+  {
+    if (!fuzz.check(seed))
+    {
+      same = false;
+      break;
+    }
+  }
+  const size_t iterations = 3000;
+  size_t checked = same ? fuzz.run(iterations) : 0;
+  same = same && checked == iterations;
+
+  std::cout << "\n  " << fuzz.seeds().size() << " seeds, " << checked << " inputs, "
+    << fuzz.tokenCount() << " reference tokens";
+  if (same)
+    std::cout << "\n  all engines return the same tokens and diagnostics";
+  else
+    std::cout << "\n  first divergence: " << fuzz.divergence().str();
+  std::cout << "\n\n";
+  return same ? 0 : 1;
+}
+#endif
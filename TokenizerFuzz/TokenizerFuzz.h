@@ -0,0 +1,134 @@
+#ifndef TOKENIZERFUZZ_H
+#define TOKENIZERFUZZ_H
+///////////////////////////////////////////////////////////////////////////////
+// TokenizerFuzz.h - differential fuzzing of the Toker engines               //
+// ver 1.2                                                                   //
+// Language:    C++, Visual Studio 2015                                      //
+// Application: Code Parser with Abstract Syntax Tree (AST), CSE687 - Object Oriented Design, SP16       //
+//              Alienware R15, Core i5, Windows 10                           //
+// Author:      Saathvik Shashidhar Gowrapura, SUID: 450734672               //
+//              sgowrapu@syr.edu, (315)-751-1059                             //
+//////////////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a TokenizerFuzz class that feeds the same bytes
+* to the reference Toker, the ConsumeState engine reading a stream, and
+* to every alternative way of tokenizing them:
+* - ConsumeState and TableLexer engines with buffer input
+* - TableLexer with stream input
+* - both engines reading an IByteSource that returns a few bytes a call
+* - both engines read in batches through getToks()
+* - both engines lexing again from a checkpoint halfway through
+* - ParallelToker with chunks of a few lines
+* - StaticToker with Toker's default configuration
+* Each is run with and without returned comments, then with returned
+* comments and directives, and the buffer input ones at each SIMD level
+* the processor supports.  Token text, kind,
+* and offset, and the diagnostics, must all be the same, and no engine
+* may throw.  check() stops at the first token where an engine differs
+* from the reference and describes it in divergence().
+*
+* run() checks random inputs built from C++ fragments and malformed
+* bytes, and mutations of seed sources: flipped bytes and inserted,
+* deleted, or repeated ranges.  Inputs are generated by a std::mt19937
+* with the given seed, so a failing run can be repeated.
+*
+* Building TokenizerFuzz.cpp with TOKENIZERFUZZ_LIBFUZZER defined adds
+* LLVMFuzzerTestOneInput(), so libFuzzer can drive check() instead.
+*
+* Public Interface:
+* -----------------
+* TokenizerFuzz fuzz(42);
+* fuzz.addSeedFile("../Tokenizer/Tokenizer.cpp");
+* if (!fuzz.check(text.data(), text.size()))
+*   std::cout << fuzz.divergence().str();
+* size_t checked = fuzz.run(10000);          // stops at first divergence
+*
+* Build Process:
+* --------------
+* Required Files: TokenizerFuzz.h, TokenizerFuzz.cpp,
+*                 Tokenizer.h, Tokenizer.cpp, MappedFile.h, MappedFile.cpp,
+*                 CharScan.h, CharScan.cpp, SpecialTokens.h, SpecialTokens.cpp,
+*                 TokenTable.h, TokenTable.cpp, LineIndex.h, LineIndex.cpp,
+*                 ByteSource.h, ByteSource.cpp, Conditionals.h, Conditionals.cpp,
+*                 ParallelToker.h, ParallelToker.cpp, StaticToker.h, StaticToker.cpp,
+*                 Utilities.h, Utilities.cpp
+*
+* Build Command: devenv Project2HelperCode.sln /rebuild debug
+*                clang++ -fsanitize=fuzzer,address -DTOKENIZERFUZZ_LIBFUZZER ...
+*
+* Maintenance History:
+* --------------------
+* ver 1.2 : 18 Oct 2026
+* - checks Tokers resumed from a checkpoint
+* ver 1.1 : 18 Oct 2026
+* - checks returnDirectives() too
+* ver 1.0 : 18 Oct 2026
+* - first release
+*/
+#include <random>
+#include <string>
+#include <vector>
+#include "../Tokenizer/Tokenizer.h"
+
+namespace Scanner
+{
+  enum class FuzzEngine {
+    statesStream, statesBuffer, statesSource, statesBatch, statesResumed,
+    tableStream, tableBuffer, tableSource, tableBatch, tableResumed,
+    parallel, fixed
+  };
+
+  const char* fuzzEngineName(FuzzEngine engine);
+
+  /////////////////////////////////////////////////////////////////////
+  // FuzzToken: a token copied out of the Toker that returned it
+
+  struct FuzzToken
+  {
+    std::string text;
+    TokenKind kind;
+    size_t offset;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // FuzzDivergence: first difference between an engine and reference
+
+  struct FuzzDivergence
+  {
+    FuzzEngine engine = FuzzEngine::statesStream;
+    const char* scanLevel = "";
+    bool returnsComments = false;
+    bool returnsDirectives = false;
+    std::string what;
+    std::string input;
+    std::string str() const;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // TokenizerFuzz: compares every engine with the reference Toker
+
+  class TokenizerFuzz
+  {
+  public:
+    TokenizerFuzz(unsigned seed = 1) : _random(seed) {}
+    bool addSeedFile(const std::string& fileSpec);
+    void addSeed(const std::string& source) { _seeds.push_back(source); }
+    const std::vector<std::string>& seeds() const { return _seeds; }
+    bool check(const char* pData, size_t size);
+    bool check(const std::string& input) { return check(input.data(), input.size()); }
+    size_t run(size_t iterations);
+    std::string randomInput();
+    std::string mutate(const std::string& source);
+    const FuzzDivergence& divergence() const { return _divergence; }
+    size_t tokenCount() const { return _tokenCount; }
+  private:
+    size_t pick(size_t n) { return n > 0 ? _random() % n : 0; }
+    std::mt19937 _random;
+    std::vector<std::string> _seeds;
+    FuzzDivergence _divergence;
+    size_t _tokenCount = 0;
+  };
+}
+#endif